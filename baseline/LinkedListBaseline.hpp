@@ -0,0 +1,188 @@
+#ifndef LINKED_LIST_BASELINE_HPP
+#define LINKED_LIST_BASELINE_HPP
+
+#include <atomic>
+#include <iostream>
+#include "NoReclamation.hpp"
+
+template<typename T, template<typename> class Reclaimer>
+class LinkedList_Baseline {
+
+private:
+    struct Node {
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* item) 
+        { 
+            this->item = item;
+            this->next.store(nullptr);
+        }
+    };
+
+    bool isMarked(Node * node) {
+    	return ((size_t) node & 0x1);
+    }
+
+    Node * getMarked(Node * node) {
+    	return (Node*)((size_t) node | 0x1);
+    }
+
+    Node * getUnmarked(Node * node) {
+    	return (Node*)((size_t) node & (~0x1));
+    }
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    int numThreads;
+    Reclaimer<Node> reclaimer {numThreads};
+
+public:
+
+    LinkedList_Baseline(int numThreads) : numThreads{numThreads}
+    {
+        Node* sentinel = new Node(nullptr);
+        head.store(sentinel);
+        tail.store(sentinel);
+        head.load()->next.store(tail.load());
+    }
+
+    ~LinkedList_Baseline()
+    {
+        Node* node = getUnmarked(head.load());
+        while(node != tail.load())
+        {
+            Node* next = getUnmarked(node->next.load());
+            delete node;
+            node = next;
+        }
+        delete tail.load();
+    }
+
+    bool add(T* item, int threadID)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        Node* node = new Node(item);
+        reclaimer.start_op(threadID);
+        while (true) {
+            if (find(item, &pred, &curr, &next, threadID)) 
+            {
+                delete node;
+                reclaimer.end_op(threadID);
+                return false;
+            }
+            node->next.store(curr, std::memory_order_relaxed);
+            Node *temp = getUnmarked(curr);
+            if (pred->compare_exchange_strong(temp, node)) 
+            {
+                reclaimer.end_op(threadID);
+                return true;
+            }
+        }
+    }
+
+    bool remove(T* item, int threadID)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        reclaimer.start_op(threadID);
+        while (true) 
+        {
+            if (!find(item, &pred, &curr, &next, threadID)) {
+                reclaimer.end_op(threadID);
+                return false;
+            }
+            Node *temp = getUnmarked(next);
+            if (!curr->next.compare_exchange_strong(temp, getMarked(next))) {
+                continue;
+            }
+            temp = getUnmarked(curr);
+            if (pred->compare_exchange_strong(temp, getUnmarked(next))) 
+            {
+                reclaimer.retireNode(getUnmarked(curr), threadID);
+            }
+            reclaimer.end_op(threadID);
+            return true;
+        }
+    }
+
+    bool contains (T* item, int threadID)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        reclaimer.start_op(threadID);
+        bool found = find(item, &pred, &curr, &next, threadID);
+        reclaimer.end_op(threadID);
+        return found;
+    }
+
+    uint64_t getRetiredCountLinkedList(int threadID)
+    {
+        return reclaimer.getRetiredNodeCount(threadID);
+    }
+
+
+private:
+
+    bool find (T* item, std::atomic<Node*> **par_pred, Node **par_curr, Node **par_next, const int threadID)
+    {
+        std::atomic<Node*> *pred;
+        Node *curr, *next;
+     try_again:
+        pred = &head;
+        curr = pred->load();
+        while (true) {
+            if (getUnmarked(curr) == nullptr) 
+            {
+                break;
+            }
+            next = curr->next.load();
+            if (getUnmarked(curr)->next.load() != next) 
+            {
+                goto try_again;
+            }
+            if (getUnmarked(next) == tail.load()) 
+            {
+                break;
+            }
+            if (pred->load() != getUnmarked(curr)) 
+            {
+                goto try_again;
+            }
+            if (getUnmarked(next) == next) 
+            {
+                if (getUnmarked(curr)->item != nullptr && !(*getUnmarked(curr)->item < *item)) 
+                {
+                    *par_curr = curr;
+                    *par_pred = pred;
+                    *par_next = next;
+                    return (*getUnmarked(curr)->item == *item);
+                }
+                pred = &getUnmarked(curr)->next;
+            } 
+            else 
+            {
+                Node *temp = getUnmarked(curr);
+                if (!pred->compare_exchange_strong(temp, getUnmarked(next))) 
+                {
+                    goto try_again;
+                }
+                reclaimer.retireNode(getUnmarked(curr), threadID);
+            }
+            curr = next;
+        }
+        *par_curr = curr;
+        *par_pred = pred;
+        *par_next = next;
+        return false;
+    }
+};
+
+template<typename T>
+using LinkedList_Leak = LinkedList_Baseline<T, LeakReclamation>;
+
+template<typename T>
+using LinkedList_Ideal = LinkedList_Baseline<T, IdealReclamation>;
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef NO_RECLAMATION_HPP
+#define NO_RECLAMATION_HPP
+
+#include <iostream>
+#include <atomic>
+#include <vector>
+
+#define MAX_NUMBER_OF_THREADS_BASELINE 64
+
+// Upper bound for the benchmarks: retired nodes are never freed while the data
+// structure is in use. They are only kept so the destructor can release them
+// between runs.
+template<typename T>
+class LeakReclamation{
+
+private:
+    int numThreads;
+    std::vector<T*> retiredList[MAX_NUMBER_OF_THREADS_BASELINE];
+    uint64_t retiredNodesCount[MAX_NUMBER_OF_THREADS_BASELINE];
+
+public:
+    LeakReclamation(int threadCount)
+    {
+        numThreads = threadCount;
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_BASELINE; i++)
+        {
+            retiredNodesCount[i] = 0;
+        }
+    }
+
+    ~LeakReclamation()
+    {
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_BASELINE; i++)
+        {
+            for(auto node : retiredList[i])
+            {
+                delete node;
+            }
+        }
+    }
+
+    void start_op(int) { }
+
+    void end_op(int) { }
+
+    void retireNode(T* obj, int threadID)
+    {
+        if(obj == nullptr)
+        {
+            return;
+        }
+        retiredList[threadID].push_back(obj);
+        retiredNodesCount[threadID] += 1;
+    }
+
+    uint64_t getRetiredNodeCount(int threadID)
+    {
+        return retiredNodesCount[threadID];
+    }
+};
+
+// Frees a node as soon as it is retired, ignoring concurrent readers. This is
+// NOT safe and only exists to measure the cost of the allocator without any
+// reclamation bookkeeping; run it single threaded or expect crashes.
+template<typename T>
+class IdealReclamation{
+
+private:
+    int numThreads;
+
+public:
+    IdealReclamation(int threadCount)
+    {
+        numThreads = threadCount;
+    }
+
+    void start_op(int) { }
+
+    void end_op(int) { }
+
+    void retireNode(T* obj, int)
+    {
+        delete obj;
+    }
+
+    uint64_t getRetiredNodeCount(int)
+    {
+        return 0;
+    }
+};
+#endif
@@ -0,0 +1,204 @@
+#ifndef STACK_BASELINE_HPP
+#define STACK_BASELINE_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "NoReclamation.hpp"
+
+template<typename T, template<typename> class Reclaimer>
+class Stack_Baseline {
+private:
+    struct Node {
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* item)
+        {
+            this->item = item;
+            this->next.store(nullptr);
+        }
+    };
+
+    std::atomic<Node*> top;
+    const int numOfThreads;
+    Reclaimer<Node> reclaimer{numOfThreads};
+
+public:
+
+    Stack_Baseline(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = new Node(nullptr);
+        top.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~Stack_Baseline(){
+        while(pop(0) != nullptr);
+        delete top.load();
+    }
+
+    bool push(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = new Node(item);
+        reclaimer.start_op(threadID);
+        while(true)
+        {
+            Node* temp = top.load();
+            node->next.store(temp, std::memory_order_relaxed);
+            if(top.compare_exchange_strong(temp,node))
+            {
+                reclaimer.end_op(threadID);
+                return true;
+            }
+        }   
+    }
+
+    T* pop(int threadID)
+    {
+        Node *temp, *next;
+        T* ret_data;
+        reclaimer.start_op(threadID);
+        while(true)
+        {
+            temp = top.load();
+            if(temp == nullptr)
+            {
+                reclaimer.end_op(threadID);
+                return nullptr;
+            }
+            next = temp->next.load();
+            if(top.compare_exchange_strong(temp, next))
+            {
+                ret_data = temp->item;
+                reclaimer.retireNode(temp,threadID);
+                reclaimer.end_op(threadID);
+                return ret_data;
+            }
+        }
+    }
+
+    // Links the items into a private chain and splices it onto top with one
+    // CAS, so the last item ends up on top. Null items are skipped.
+    template<typename Iterator>
+    bool pushBatch(Iterator first, Iterator last, int threadID)
+    {
+        Node* bottom = nullptr;
+        Node* chain = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = new Node(*first);
+            node->next.store(chain, std::memory_order_relaxed);
+            if(bottom == nullptr)
+            {
+                bottom = node;
+            }
+            chain = node;
+        }
+        if(chain == nullptr)
+        {
+            return false;
+        }
+        reclaimer.start_op(threadID);
+        while(true)
+        {
+            Node* temp = top.load();
+            bottom->next.store(temp, std::memory_order_relaxed);
+            if(top.compare_exchange_strong(temp,chain))
+            {
+                reclaimer.end_op(threadID);
+                return true;
+            }
+        }
+    }
+
+    // Detaches up to n nodes with one CAS. Leaked nodes are never freed, and
+    // top only changes by CAS, so while top is still first the chain below it
+    // is unchanged. Stops, like pop, at the sentinel.
+    int popBatch(int n, T** out, int threadID)
+    {
+        Node *first, *last;
+        reclaimer.start_op(threadID);
+        while(true)
+        {
+            first = top.load();
+            if(first == nullptr || n <= 0)
+            {
+                reclaimer.end_op(threadID);
+                return 0;
+            }
+            last = first;
+            for(int taken = 1; taken < n && last->item != nullptr; taken++)
+            {
+                Node* next = last->next.load();
+                if(next == nullptr)
+                {
+                    break;
+                }
+                last = next;
+            }
+            if(top.compare_exchange_strong(first, last->next.load()))
+            {
+                break;
+            }
+        }
+        int count = 0;
+        Node* node = first;
+        while(true)
+        {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            if(node->item != nullptr)
+            {
+                out[count++] = node->item;
+            }
+            reclaimer.retireNode(node,threadID);
+            if(node == last)
+            {
+                break;
+            }
+            node = next;
+        }
+        reclaimer.end_op(threadID);
+        return count;
+    }
+
+    // Takes the whole stack with one exchange; the detached chain is private
+    // and is retired node by node. Items come out in pop order.
+    std::vector<T*> popAll(int threadID)
+    {
+        std::vector<T*> items;
+        reclaimer.start_op(threadID);
+        Node* node = top.exchange(nullptr);
+        while(node != nullptr)
+        {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            if(node->item != nullptr)
+            {
+                items.push_back(node->item);
+            }
+            reclaimer.retireNode(node,threadID);
+            node = next;
+        }
+        reclaimer.end_op(threadID);
+        return items;
+    }
+
+    uint64_t getRetiredCountStack(int threadID)
+    {
+        return reclaimer.getRetiredNodeCount(threadID);
+    }
+};
+
+template<typename T>
+using Stack_Leak = Stack_Baseline<T, LeakReclamation>;
+
+template<typename T>
+using Stack_Ideal = Stack_Baseline<T, IdealReclamation>;
+
+#endif
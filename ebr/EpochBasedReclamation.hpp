@@ -0,0 +1,142 @@
+#ifndef EPOCH_BASED_RECLAMATION_HPP
+#define EPOCH_BASED_RECLAMATION_HPP
+
+#include <iostream>
+#include <atomic>
+#include <vector>
+
+#define MAX_NUMBER_OF_THREADS_EBR 40
+#define EBR_LIMBO_BAGS 3
+
+template<typename T>
+class EpochBasedReclamation{
+
+private:
+    // Announcements hold the epoch shifted left by one, the low bit is set while
+    // the thread is outside an operation.
+    static const uint64_t QUIESCENT = 1;
+
+    std::atomic<uint64_t> globalEpoch{0};
+    int numThreads;
+    std::atomic<uint64_t> announcements[MAX_NUMBER_OF_THREADS_EBR];
+    uint64_t localEpoch[MAX_NUMBER_OF_THREADS_EBR];
+    int checkNext[MAX_NUMBER_OF_THREADS_EBR];
+    std::vector<T*> limboBags[MAX_NUMBER_OF_THREADS_EBR][EBR_LIMBO_BAGS];
+    uint64_t limboEpoch[MAX_NUMBER_OF_THREADS_EBR][EBR_LIMBO_BAGS];
+    uint64_t retiredNodesCount[MAX_NUMBER_OF_THREADS_EBR];
+
+public:
+    EpochBasedReclamation(int threadCount)
+    {
+        numThreads = threadCount;
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_EBR; i++)
+        {
+            announcements[i].store(QUIESCENT, std::memory_order_relaxed);
+            localEpoch[i] = 0;
+            checkNext[i] = 0;
+            retiredNodesCount[i] = 0;
+            for(int j = 0; j < EBR_LIMBO_BAGS; j++)
+            {
+                limboEpoch[i][j] = 0;
+            }
+        }
+    }
+
+    ~EpochBasedReclamation()
+    {
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_EBR; i++)
+        {
+            for(int j = 0; j < EBR_LIMBO_BAGS; j++)
+            {
+                for(auto node : limboBags[i][j])
+                {
+                    delete node;
+                }
+            }
+        }
+    }
+
+    uint64_t getGlobalEpoch()
+    {
+        return globalEpoch.load(std::memory_order_acquire);
+    }
+
+    // DEBRA-style: on every operation the thread checks one other thread's
+    // announcement, and advances the global epoch after it has seen all of them
+    // either quiescent or in the current epoch.
+    void start_op(int threadID)
+    {
+        uint64_t e = globalEpoch.load(std::memory_order_acquire);
+        if(e != localEpoch[threadID])
+        {
+            localEpoch[threadID] = e;
+            checkNext[threadID] = 0;
+            rotateLimboBags(threadID, e);
+        }
+        announcements[threadID].store(e << 1, std::memory_order_seq_cst);
+
+        uint64_t other = announcements[checkNext[threadID]].load(std::memory_order_acquire);
+        if((other & QUIESCENT) || (other >> 1) == e)
+        {
+            checkNext[threadID] += 1;
+            if(checkNext[threadID] >= numThreads)
+            {
+                globalEpoch.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+                checkNext[threadID] = 0;
+            }
+        }
+    }
+
+    void end_op(int threadID)
+    {
+        announcements[threadID].store((localEpoch[threadID] << 1) | QUIESCENT, std::memory_order_release);
+    }
+
+    // Nodes are tagged with the global epoch read after they were unlinked. Any
+    // thread that can still reach them announced that epoch or an earlier one,
+    // so they are safe to free once the global epoch is two ahead of the tag.
+    void retireNode(T* obj, int threadID)
+    {
+        if(obj == nullptr)
+        {
+            return;
+        }
+        uint64_t e = globalEpoch.load(std::memory_order_acquire);
+        int bag = e % EBR_LIMBO_BAGS;
+        if(limboEpoch[threadID][bag] != e)
+        {
+            emptyLimboBag(threadID, bag);
+            limboEpoch[threadID][bag] = e;
+        }
+        limboBags[threadID][bag].push_back(obj);
+        retiredNodesCount[threadID] += 1;
+    }
+
+    uint64_t getRetiredNodeCount(int threadID)
+    {
+        return retiredNodesCount[threadID];
+    }
+
+private:
+    void rotateLimboBags(int threadID, uint64_t currEpoch)
+    {
+        for(int i = 0; i < EBR_LIMBO_BAGS; i++)
+        {
+            if(limboEpoch[threadID][i] + 2 <= currEpoch)
+            {
+                emptyLimboBag(threadID, i);
+            }
+        }
+    }
+
+    void emptyLimboBag(int threadID, int bag)
+    {
+        for(auto node : limboBags[threadID][bag])
+        {
+            delete node;
+            retiredNodesCount[threadID] -= 1;
+        }
+        limboBags[threadID][bag].clear();
+    }
+};
+#endif
@@ -0,0 +1,218 @@
+#ifndef QUEUE_EBR_HPP
+#define QUEUE_EBR_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include <climits>
+#include "EpochBasedReclamation.hpp"
+
+template<typename T>
+class Queue_EBR
+{
+
+private:
+    struct Node{
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* item) 
+        {
+            this->item = item;
+            this->next.store(nullptr);
+        }
+
+        bool casNext(Node *cmp, Node *val) {
+            return next.compare_exchange_strong(cmp, val);
+        }
+    };
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    const int numOfThreads;
+    EpochBasedReclamation<Node> ebrQueue{numOfThreads};
+
+public:
+
+    Queue_EBR(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = new Node(nullptr);
+        head.store(sentinel, std::memory_order_relaxed);
+        tail.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~Queue_EBR(){
+        while(dequeue(0) != nullptr);
+        delete head.load();
+    }
+
+    bool enqueue(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = new Node(item);
+        ebrQueue.start_op(threadID);
+        while(true)
+        {
+            Node* temp = tail.load();
+            Node* next  = temp->next.load();
+            if (temp == tail.load()) 
+            {
+                if (next == nullptr) 
+                {
+                    if (temp->casNext(nullptr, node)) 
+                    {
+                        tail.compare_exchange_strong(temp, node);
+                        ebrQueue.end_op(threadID);
+                        return true;
+                    }
+                } 
+                else 
+                {
+                    tail.compare_exchange_strong(temp, next);
+                }
+            }
+        }
+    }
+
+    T* dequeue(int threadID)
+    {
+        ebrQueue.start_op(threadID);
+        Node* node = head.load();
+        while (node != tail.load()) 
+        {
+            Node* next = node->next.load();
+            if (head.compare_exchange_strong(node, next)) 
+            {
+                T* item = next->item;
+                ebrQueue.retireNode(node, threadID);
+                ebrQueue.end_op(threadID);
+                return item;
+            }
+            node = head.load();
+        }
+        ebrQueue.end_op(threadID);
+        return nullptr;
+    }
+
+    // Links the items into a private chain, appends it with one CAS on the
+    // last node's next and then swings tail to the end of the chain. Null
+    // items are skipped.
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last, int threadID)
+    {
+        Node* chainFirst = nullptr;
+        Node* chainLast = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = new Node(*first);
+            if(chainLast == nullptr)
+            {
+                chainFirst = node;
+            }
+            else
+            {
+                chainLast->next.store(node, std::memory_order_relaxed);
+            }
+            chainLast = node;
+        }
+        if(chainFirst == nullptr)
+        {
+            return false;
+        }
+        ebrQueue.start_op(threadID);
+        while(true)
+        {
+            Node* temp = tail.load();
+            Node* next  = temp->next.load();
+            if (temp == tail.load()) 
+            {
+                if (next == nullptr) 
+                {
+                    if (temp->casNext(nullptr, chainFirst)) 
+                    {
+                        tail.compare_exchange_strong(temp, chainLast);
+                        ebrQueue.end_op(threadID);
+                        return true;
+                    }
+                } 
+                else 
+                {
+                    tail.compare_exchange_strong(temp, next);
+                }
+            }
+        }
+    }
+
+    int dequeueBatch(int n, T** out, int threadID)
+    {
+        std::vector<T*> items;
+        dequeueChain(n, items, threadID);
+        for(size_t i = 0; i < items.size(); i++)
+        {
+            out[i] = items[i];
+        }
+        return (int)items.size();
+    }
+
+    // Everything up to the tail seen while walking, with one CAS on head
+    std::vector<T*> drain(int threadID)
+    {
+        std::vector<T*> items;
+        dequeueChain(INT_MAX, items, threadID);
+        return items;
+    }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return ebrQueue.getRetiredNodeCount(threadID);
+    }
+
+private:
+    // Walks up to n nodes past head, never past tail, and moves head to the
+    // last of them with one CAS. Nothing reachable from head is freed before the operation ends and next links never change once set,
+    // so while head is still node the walked chain is exactly what the CAS
+    // detaches.
+    void dequeueChain(int n, std::vector<T*>& items, int threadID)
+    {
+        ebrQueue.start_op(threadID);
+        while(true)
+        {
+            items.clear();
+            Node* node = head.load();
+            Node* last = node;
+            while((int)items.size() < n && last != tail.load())
+            {
+                Node* next = last->next.load();
+                if(next == nullptr)
+                {
+                    break;
+                }
+                items.push_back(next->item);
+                last = next;
+            }
+            if(last == node)
+            {
+                break;
+            }
+            if(head.compare_exchange_strong(node, last))
+            {
+                while(node != last)
+                {
+                    Node* next = node->next.load(std::memory_order_relaxed);
+                    ebrQueue.retireNode(node, threadID);
+                    node = next;
+                }
+                break;
+            }
+        }
+        ebrQueue.end_op(threadID);
+    }
+};
+
+#endif
@@ -0,0 +1,346 @@
+#ifndef ALLOCATORS_HPP
+#define ALLOCATORS_HPP
+
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+#include "HugePageArena.hpp"
+
+#define SLAB_BLOCKS_PER_SLAB 256
+#define SLAB_BLOCK_HEADER 16
+#define RECYCLE_CACHE_SIZE 256
+#define RECYCLE_POOL_BATCHES 64
+
+// Node allocators plugged into Stack, Queue and List. An allocator for node
+// type Node provides
+//
+//   static void* allocate()
+//   static void deallocate(void* ptr)
+//
+// The containers' nodes route their operator new and delete through it, so
+// the reclaimers free nodes with a plain delete whichever allocator is used.
+
+template<typename Node>
+struct HeapAllocator {
+    static void* allocate() { return ::operator new(sizeof(Node)); }
+
+    static void deallocate(void* ptr) { ::operator delete(ptr); }
+};
+
+// Where SlabAllocator gets its slabs from
+struct HeapSlabs {
+    static void* allocate(size_t size) { return ::operator new(size); }
+};
+
+struct HugePageSlabs {
+    static void* allocate(size_t size) { return HugePageArena::global().allocate(size); }
+};
+
+// Per-thread slabs of fixed-size blocks. Allocation pops the thread's own
+// free list; a block freed by its owner goes straight back on it. A block
+// freed by another thread, which is what reclamation mostly does, is pushed
+// on the owner's lock-free return list, and the owner takes the whole list
+// back in one exchange once its free list runs dry.
+//
+// Each block starts with a header naming the cache that carved it. When a
+// thread exits its cache is parked, still receiving remote frees, and the
+// next new thread adopts it. Slabs are kept until the process exits.
+template<typename Node, typename Slabs>
+class PerThreadSlabAllocator {
+private:
+    struct Block {
+        Block* next;
+    };
+
+    struct Cache {
+        Block* localFree{nullptr};
+        std::atomic<Block*> remoteFree{nullptr};
+        std::vector<char*> slabs;
+    };
+
+    struct Pool {
+        std::mutex lock;
+        std::vector<Cache*> parked;
+    };
+
+    // Released when the thread exits; freeing afterwards, from thread-local
+    // or static destructors, goes to the parked cache as a remote free
+    struct Registration {
+        Cache* cache{nullptr};
+
+        ~Registration()
+        {
+            if (cache == nullptr) {
+                return;
+            }
+            owned = nullptr;
+            Pool& p = pool();
+            std::lock_guard<std::mutex> guard(p.lock);
+            p.parked.push_back(cache);
+        }
+    };
+
+    static constexpr size_t blockSize =
+        (SLAB_BLOCK_HEADER + sizeof(Node) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    static thread_local Cache* owned;
+
+    // Never destroyed, so caches parked at exit stay valid for the frees
+    // done by static destructors
+    static Pool& pool()
+    {
+        static Pool* p = new Pool();
+        return *p;
+    }
+
+    static Cache* ownCache()
+    {
+        if (owned != nullptr) {
+            return owned;
+        }
+        static thread_local Registration registration;
+        Cache* cache = nullptr;
+        {
+            Pool& p = pool();
+            std::lock_guard<std::mutex> guard(p.lock);
+            if (!p.parked.empty()) {
+                cache = p.parked.back();
+                p.parked.pop_back();
+            }
+        }
+        if (cache == nullptr) {
+            cache = new Cache();
+        }
+        registration.cache = cache;
+        owned = cache;
+        return cache;
+    }
+
+    static Cache*& ownerOf(Block* block)
+    {
+        return *(Cache**)((char*)block - SLAB_BLOCK_HEADER);
+    }
+
+    static void refill(Cache* cache)
+    {
+        cache->localFree = cache->remoteFree.exchange(nullptr, std::memory_order_acquire);
+        if (cache->localFree != nullptr) {
+            return;
+        }
+        char* slab = (char*)Slabs::allocate(blockSize * SLAB_BLOCKS_PER_SLAB);
+        cache->slabs.push_back(slab);
+        for (int i = SLAB_BLOCKS_PER_SLAB - 1; i >= 0; i--) {
+            Block* block = (Block*)(slab + i * blockSize + SLAB_BLOCK_HEADER);
+            ownerOf(block) = cache;
+            block->next = cache->localFree;
+            cache->localFree = block;
+        }
+    }
+
+public:
+    static void* allocate()
+    {
+        Cache* cache = ownCache();
+        if (cache->localFree == nullptr) {
+            refill(cache);
+        }
+        Block* block = cache->localFree;
+        cache->localFree = block->next;
+        return block;
+    }
+
+    static void deallocate(void* ptr)
+    {
+        Block* block = (Block*)ptr;
+        Cache* cache = ownerOf(block);
+        if (cache == owned) {
+            block->next = cache->localFree;
+            cache->localFree = block;
+            return;
+        }
+        Block* head = cache->remoteFree.load(std::memory_order_relaxed);
+        do {
+            block->next = head;
+        } while (!cache->remoteFree.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+    }
+};
+
+template<typename Node, typename Slabs>
+thread_local typename PerThreadSlabAllocator<Node, Slabs>::Cache* PerThreadSlabAllocator<Node, Slabs>::owned = nullptr;
+
+template<typename Node>
+using SlabAllocator = PerThreadSlabAllocator<Node, HeapSlabs>;
+
+// Slabs carved in sequence from huge pages, so long list traversals touch
+// far fewer TLB entries
+template<typename Node>
+using HugePageAllocator = PerThreadSlabAllocator<Node, HugePageSlabs>;
+
+// Recycles reclaimed nodes through the thread that reclaims them: a freed
+// node goes into that thread's bounded cache and its next allocation takes
+// it back, so a thread that dequeues and enqueues in steady state never
+// calls the allocator. A full cache hands half of itself to a shared pool
+// as one batch, and an empty one takes a batch back or, when the pool has
+// none, allocates half a cache from the heap at once, so a thread that only
+// enqueues looks at the pool once per batch and not once per node. Unlike
+// the slab allocators nodes have no owner, so any thread may keep any node.
+template<typename Node>
+class RecyclingAllocator {
+private:
+    struct Block {
+        Block* next;
+    };
+
+    struct Cache {
+        Block* head;
+        int count;
+        bool exited;
+    };
+
+    struct Pool {
+        std::mutex lock;
+        std::vector<Block*> batches;
+        // batches.size(), readable without the lock
+        std::atomic<int> available{0};
+    };
+
+    // Hands the cache to the pool when the thread exits; later frees on the
+    // thread, from thread-local or static destructors, go straight to the heap
+    struct Registration {
+        ~Registration()
+        {
+            if (cache.head != nullptr) {
+                release(cache.head);
+            }
+            cache.head = nullptr;
+            cache.count = 0;
+            cache.exited = true;
+        }
+    };
+
+    static thread_local Cache cache;
+
+    // Never destroyed, like the slab allocators' pool
+    static Pool& pool()
+    {
+        static Pool* p = new Pool();
+        return *p;
+    }
+
+    static void release(Block* batch)
+    {
+        {
+            Pool& p = pool();
+            std::lock_guard<std::mutex> guard(p.lock);
+            if (p.batches.size() < RECYCLE_POOL_BATCHES) {
+                p.batches.push_back(batch);
+                p.available.store((int)p.batches.size(), std::memory_order_relaxed);
+                return;
+            }
+        }
+        while (batch != nullptr) {
+            Block* next = batch->next;
+            ::operator delete(batch);
+            batch = next;
+        }
+    }
+
+    static Block* acquire()
+    {
+        Pool& p = pool();
+        if (p.available.load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> guard(p.lock);
+        if (p.batches.empty()) {
+            return nullptr;
+        }
+        Block* batch = p.batches.back();
+        p.batches.pop_back();
+        p.available.store((int)p.batches.size(), std::memory_order_relaxed);
+        return batch;
+    }
+
+    static void refill()
+    {
+        Block* batch = acquire();
+        int count = 0;
+        for (Block* block = batch; block != nullptr; block = block->next) {
+            count++;
+        }
+        if (batch == nullptr) {
+            for (; count < RECYCLE_CACHE_SIZE / 2; count++) {
+                Block* block = (Block*)::operator new(sizeof(Node));
+                block->next = batch;
+                batch = block;
+            }
+        }
+        cache.head = batch;
+        cache.count = count;
+    }
+
+    static void registerThread()
+    {
+        static thread_local Registration registration;
+        (void)registration;
+    }
+
+public:
+    static void* allocate()
+    {
+        if (cache.head == nullptr && !cache.exited) {
+            registerThread();
+            refill();
+        }
+        if (cache.head == nullptr) {
+            return ::operator new(sizeof(Node));
+        }
+        Block* block = cache.head;
+        cache.head = block->next;
+        cache.count--;
+        return block;
+    }
+
+    static void deallocate(void* ptr)
+    {
+        if (cache.exited) {
+            ::operator delete(ptr);
+            return;
+        }
+        registerThread();
+        if (cache.count == RECYCLE_CACHE_SIZE) {
+            Block* batch = cache.head;
+            Block* last = batch;
+            for (int i = 1; i < RECYCLE_CACHE_SIZE / 2; i++) {
+                last = last->next;
+            }
+            cache.head = last->next;
+            last->next = nullptr;
+            cache.count -= RECYCLE_CACHE_SIZE / 2;
+            release(batch);
+        }
+        Block* block = (Block*)ptr;
+        block->next = cache.head;
+        cache.head = block;
+        cache.count++;
+    }
+};
+
+template<typename Node>
+thread_local typename RecyclingAllocator<Node>::Cache RecyclingAllocator<Node>::cache = {nullptr, 0, false};
+
+#ifndef DEFAULT_NODE_ALLOCATOR
+#define DEFAULT_NODE_ALLOCATOR SlabAllocator
+#endif
+
+// The Michael-Scott queues and the MultiQueue built from them default to
+// RecyclingAllocator instead, as their nodes are freed by whichever thread
+// reclaims them
+#ifndef QUEUE_NODE_ALLOCATOR
+#define QUEUE_NODE_ALLOCATOR RecyclingAllocator
+#endif
+
+#endif
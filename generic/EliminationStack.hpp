@@ -0,0 +1,187 @@
+#ifndef GENERIC_ELIMINATION_STACK_HPP
+#define GENERIC_ELIMINATION_STACK_HPP
+
+#include <atomic>
+#include <iostream>
+#include <cstdint>
+#include "Reclaimers.hpp"
+#include "Allocators.hpp"
+#include "ThreadContext.hpp"
+
+#define ELIMINATION_ARRAY_SIZE 16
+#define ELIMINATION_SPINS 128
+#define ELIMINATION_TAKEN ((uintptr_t)0x1)
+
+// Treiber stack with an elimination array in front of it (Hendler, Shavit
+// and Yerushalmi). A push or pop whose CAS on top fails tries to meet an
+// operation of the other kind in a random slot of the array: the push
+// offers its item there and a pop that finds it takes it, so both finish
+// without touching top. Only items pass through the array, never nodes, so
+// eliminated operations need nothing from the reclaimer; everything that
+// goes through top is protected and retired as in Stack.
+template<typename T, template<typename> class Reclaimer, template<typename> class Allocator = DEFAULT_NODE_ALLOCATOR>
+class EliminationStack {
+private:
+    struct Node : NodeHeaderOf<Reclaimer>::type {
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* item) : item{item}, next{nullptr} { }
+
+        static void* operator new(size_t) { return Allocator<Node>::allocate(); }
+
+        static void operator delete(void* ptr) { Allocator<Node>::deallocate(ptr); }
+    };
+
+    // Empty, an offered item, or ELIMINATION_TAKEN once a pop has taken it
+    // and until the pusher that offered it sees so
+    struct alignas(64) Slot {
+        std::atomic<uintptr_t> offer{0};
+    };
+
+    std::atomic<Node*> top;
+    const int numOfThreads;
+    Reclaimer<Node> reclaimer{numOfThreads};
+    Slot eliminationArray[ELIMINATION_ARRAY_SIZE];
+
+    // Fewer slots than threads, so colliding operations are likely to meet
+    Slot& randomSlot()
+    {
+        static thread_local uint64_t seed = (uint64_t)(uintptr_t)&seed | 1;
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        int range = numOfThreads / 2;
+        if (range < 1)
+        {
+            range = 1;
+        }
+        if (range > ELIMINATION_ARRAY_SIZE)
+        {
+            range = ELIMINATION_ARRAY_SIZE;
+        }
+        return eliminationArray[seed % range];
+    }
+
+    bool eliminatePush(T* item)
+    {
+        Slot& slot = randomSlot();
+        uintptr_t expected = 0;
+        if (!slot.offer.compare_exchange_strong(expected, (uintptr_t)item))
+        {
+            return false;
+        }
+        for (int i = 0; i < ELIMINATION_SPINS; i++)
+        {
+            if (slot.offer.load(std::memory_order_acquire) == ELIMINATION_TAKEN)
+            {
+                break;
+            }
+        }
+        expected = (uintptr_t)item;
+        if (slot.offer.compare_exchange_strong(expected, 0))
+        {
+            return false;
+        }
+        slot.offer.store(0, std::memory_order_release);
+        return true;
+    }
+
+    T* eliminatePop()
+    {
+        Slot& slot = randomSlot();
+        for (int i = 0; i < ELIMINATION_SPINS; i++)
+        {
+            uintptr_t offer = slot.offer.load(std::memory_order_acquire);
+            if (offer != 0 && offer != ELIMINATION_TAKEN && slot.offer.compare_exchange_strong(offer, ELIMINATION_TAKEN))
+            {
+                return (T*)offer;
+            }
+        }
+        return nullptr;
+    }
+
+public:
+
+    EliminationStack(int numOfThreads) : numOfThreads{numOfThreads}
+    {
+        Node* sentinel = reclaimer.alloc(new Node(nullptr), 0);
+        top.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~EliminationStack()
+    {
+        while(pop(0) != nullptr);
+        delete top.load();
+    }
+
+    bool push(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = reclaimer.alloc(new Node(item), threadID);
+        reclaimer.begin(threadID);
+        while(true)
+        {
+            Node* temp = top.load();
+            node->next.store(temp, std::memory_order_relaxed);
+            if(top.compare_exchange_strong(temp, node))
+            {
+                reclaimer.end(threadID);
+                return true;
+            }
+            if(eliminatePush(item))
+            {
+                // Never published, so no reader can hold it
+                delete node;
+                reclaimer.end(threadID);
+                return true;
+            }
+        }
+    }
+
+    T* pop(int threadID)
+    {
+        reclaimer.begin(threadID);
+        while(true)
+        {
+            Node* temp = reclaimer.protect(0, top, threadID);
+            if(temp == nullptr)
+            {
+                reclaimer.end(threadID);
+                return nullptr;
+            }
+            Node* next = temp->next.load();
+            if(top.compare_exchange_strong(temp, next))
+            {
+                T* ret_data = temp->item;
+                reclaimer.retire(temp, threadID);
+                reclaimer.end(threadID);
+                return ret_data;
+            }
+            T* item = eliminatePop();
+            if(item != nullptr)
+            {
+                reclaimer.end(threadID);
+                return item;
+            }
+        }
+    }
+
+    bool push(T* item, const ThreadContext& context) { return push(item, context.id(numOfThreads)); }
+
+    T* pop(const ThreadContext& context) { return pop(context.id(numOfThreads)); }
+
+    bool push(T* item) { return push(item, ThreadContext::current()); }
+
+    T* pop() { return pop(ThreadContext::current()); }
+
+    uint64_t getRetiredCountStack(int threadID)
+    {
+        return reclaimer.retiredCount(threadID);
+    }
+};
+
+#endif
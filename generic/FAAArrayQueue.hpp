@@ -0,0 +1,191 @@
+#ifndef GENERIC_FAA_ARRAY_QUEUE_HPP
+#define GENERIC_FAA_ARRAY_QUEUE_HPP
+
+#include <atomic>
+#include <iostream>
+#include "Reclaimers.hpp"
+#include "Allocators.hpp"
+#include "ThreadContext.hpp"
+#include "ParkingLot.hpp"
+
+#define FAA_BUFFER_SIZE 1024
+
+// FAA array queue (Correia and Ramalhete): a Michael-Scott list of segments,
+// each holding FAA_BUFFER_SIZE item slots. Enqueuers and dequeuers claim
+// slots with fetch_add on the segment's indices and only fall back to CAS
+// on the links to append a segment or to step head past a used up one. A
+// node is allocated and retired once per segment instead of once per item.
+// Slot 0 holds the head or tail segment.
+template<typename T, template<typename> class Reclaimer, template<typename> class Allocator = DEFAULT_NODE_ALLOCATOR>
+class FAAArrayQueue
+{
+
+private:
+    struct Node : NodeHeaderOf<Reclaimer>::type {
+        std::atomic<int> deqidx;
+        std::atomic<T*> items[FAA_BUFFER_SIZE];
+        std::atomic<int> enqidx;
+        std::atomic<Node*> next;
+
+        // The new segment starts out holding item, so enqidx begins at 1
+        Node(T* item) : deqidx{0}, enqidx{1}, next{nullptr}
+        {
+            items[0].store(item, std::memory_order_relaxed);
+            for (int i = 1; i < FAA_BUFFER_SIZE; i++)
+            {
+                items[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        bool casNext(Node *cmp, Node *val) {
+            return next.compare_exchange_strong(cmp, val);
+        }
+
+        static void* operator new(size_t) { return Allocator<Node>::allocate(); }
+
+        static void operator delete(void* ptr) { Allocator<Node>::deallocate(ptr); }
+    };
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    const int numOfThreads;
+    Reclaimer<Node> reclaimer{numOfThreads};
+    ParkingLot parking;
+
+    // Written into a slot by a dequeuer that got there before the enqueuer,
+    // which then has to claim another slot
+    T* taken() { return (T*)&taken_marker; }
+    char taken_marker;
+
+public:
+
+    FAAArrayQueue(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = reclaimer.alloc(new Node(nullptr), 0);
+        sentinel->enqidx.store(0, std::memory_order_relaxed);
+        head.store(sentinel, std::memory_order_relaxed);
+        tail.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~FAAArrayQueue(){
+        while(dequeue(0) != nullptr);
+        delete head.load();
+    }
+
+    bool enqueue(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        reclaimer.begin(threadID);
+        while(true)
+        {
+            Node* ltail = reclaimer.protect(0, tail, threadID);
+            int idx = ltail->enqidx.fetch_add(1);
+            if(idx > FAA_BUFFER_SIZE - 1)
+            {
+                // Segment full: append a new one that already holds item
+                if(ltail != tail.load())
+                {
+                    continue;
+                }
+                Node* lnext = ltail->next.load();
+                if(lnext == nullptr)
+                {
+                    Node* node = reclaimer.alloc(new Node(item), threadID);
+                    if(ltail->casNext(nullptr, node))
+                    {
+                        tail.compare_exchange_strong(ltail, node);
+                        reclaimer.end(threadID);
+                        parking.notify();
+                        return true;
+                    }
+                    delete node;
+                }
+                else
+                {
+                    tail.compare_exchange_strong(ltail, lnext);
+                }
+                continue;
+            }
+            T* expected = nullptr;
+            if(ltail->items[idx].compare_exchange_strong(expected, item))
+            {
+                reclaimer.end(threadID);
+                parking.notify();
+                return true;
+            }
+        }
+    }
+
+    T* dequeue(int threadID)
+    {
+        reclaimer.begin(threadID);
+        while(true)
+        {
+            Node* lhead = reclaimer.protect(0, head, threadID);
+            if(lhead->deqidx.load() >= lhead->enqidx.load() && lhead->next.load() == nullptr)
+            {
+                break;
+            }
+            int idx = lhead->deqidx.fetch_add(1);
+            if(idx > FAA_BUFFER_SIZE - 1)
+            {
+                // Segment used up: move head on and retire it. Tail may still
+                // point at it, so swing tail past it first, as the
+                // Michael-Scott dequeue does, or tail would be left on a
+                // retired segment.
+                Node* lnext = lhead->next.load();
+                if(lnext == nullptr)
+                {
+                    break;
+                }
+                Node* ltail = tail.load();
+                if(ltail == lhead)
+                {
+                    tail.compare_exchange_strong(ltail, lnext);
+                }
+                if(head.compare_exchange_strong(lhead, lnext))
+                {
+                    reclaimer.retire(lhead, threadID);
+                }
+                continue;
+            }
+            T* item = lhead->items[idx].exchange(taken());
+            if(item == nullptr)
+            {
+                continue;
+            }
+            reclaimer.end(threadID);
+            return item;
+        }
+        reclaimer.end(threadID);
+        return nullptr;
+    }
+
+    // Like dequeue, but parks on an empty queue until an item arrives or
+    // timeout has passed, when it returns nullptr
+    T* dequeueWait(int threadID, std::chrono::nanoseconds timeout)
+    {
+        return parking.wait([&] { return dequeue(threadID); }, timeout);
+    }
+
+    bool enqueue(T* item, const ThreadContext& context) { return enqueue(item, context.id(numOfThreads)); }
+
+    T* dequeue(const ThreadContext& context) { return dequeue(context.id(numOfThreads)); }
+
+    T* dequeueWait(const ThreadContext& context, std::chrono::nanoseconds timeout) { return dequeueWait(context.id(numOfThreads), timeout); }
+
+    bool enqueue(T* item) { return enqueue(item, ThreadContext::current()); }
+
+    T* dequeue() { return dequeue(ThreadContext::current()); }
+
+    T* dequeueWait(std::chrono::nanoseconds timeout) { return dequeueWait(ThreadContext::current(), timeout); }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return reclaimer.retiredCount(threadID);
+    }
+};
+
+#endif
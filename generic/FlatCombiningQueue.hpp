@@ -0,0 +1,221 @@
+#ifndef GENERIC_FLAT_COMBINING_QUEUE_HPP
+#define GENERIC_FLAT_COMBINING_QUEUE_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+#include "Reclaimers.hpp"
+#include "Allocators.hpp"
+#include "ThreadContext.hpp"
+#include "ParkingLot.hpp"
+
+#define FC_MAX_THREADS 64
+#define FC_COMBINING_ROUNDS 4
+#define FC_SPINS_BEFORE_YIELD 256
+#define FC_IDLE 0
+#define FC_ENQUEUE 1
+#define FC_DEQUEUE 2
+
+static_assert(FC_MAX_THREADS > 0 && FC_COMBINING_ROUNDS > 0, "FlatCombiningQueue needs records and rounds");
+
+// Flat-combining queue (Hendler, Incze, Shavit and Tzafrir). A thread posts
+// its operation in its own publication record and tries to take the lock;
+// whoever gets it becomes the combiner and applies every posted operation to
+// a plain sequential queue, up to FC_COMBINING_ROUNDS passes over the
+// records, while the others spin on their own record. Under contention one
+// thread does the work sequentially and cache-hot instead of all threads
+// failing CASes on tail.
+//
+// Nodes are only touched by the combiner, under the lock. Those dequeued by
+// a combine go through the reclaimer with one retireBatch, inside a begin/end
+// bracket held for the whole combine.
+//
+// There is one record per thread id, so the constructor rejects more than
+// FC_MAX_THREADS threads and apply rejects ids the queue was not sized for.
+// The combiner passes its own id to the reclaimer, whose policy refuses a
+// thread count its domain has no rows for, which for HP, HE and IBR is
+// below FC_MAX_THREADS.
+template<typename T, template<typename> class Reclaimer, template<typename> class Allocator = DEFAULT_NODE_ALLOCATOR>
+class FlatCombiningQueue
+{
+
+private:
+    struct Node : NodeHeaderOf<Reclaimer>::type {
+        T* item;
+        Node* next;
+
+        Node(T* item) : item{item}, next{nullptr} { }
+
+        static void* operator new(size_t) { return Allocator<Node>::allocate(); }
+
+        static void operator delete(void* ptr) { Allocator<Node>::deallocate(ptr); }
+    };
+
+    // item is the argument of an enqueue and the result of a dequeue, handed
+    // over by the release store of state back to FC_IDLE
+    struct alignas(64) Record {
+        std::atomic<int> state{FC_IDLE};
+        T* item{nullptr};
+    };
+
+    // Sentinel-headed, guarded by lock
+    Node* head;
+    Node* tail;
+    const int numOfThreads;
+    Reclaimer<Node> reclaimer{numOfThreads};
+    alignas(64) std::atomic<bool> lock{false};
+    Record records[FC_MAX_THREADS];
+    ParkingLot parking;
+
+    static int checkThreads(int numOfThreads)
+    {
+        if(numOfThreads > FC_MAX_THREADS)
+        {
+            throw std::runtime_error("FlatCombiningQueue: more than FC_MAX_THREADS threads");
+        }
+        return numOfThreads;
+    }
+
+    void combine(int threadID)
+    {
+        std::vector<Node*> dequeued;
+        reclaimer.begin(threadID);
+        for(int round = 0; round < FC_COMBINING_ROUNDS; round++)
+        {
+            bool applied = false;
+            for(int tid = 0; tid < numOfThreads; tid++)
+            {
+                Record& record = records[tid];
+                int state = record.state.load(std::memory_order_acquire);
+                if(state == FC_ENQUEUE)
+                {
+                    Node* node = reclaimer.alloc(new Node(record.item), threadID);
+                    tail->next = node;
+                    tail = node;
+                }
+                else if(state == FC_DEQUEUE)
+                {
+                    Node* next = head->next;
+                    if(next == nullptr)
+                    {
+                        record.item = nullptr;
+                    }
+                    else
+                    {
+                        record.item = next->item;
+                        dequeued.push_back(head);
+                        head = next;
+                    }
+                }
+                else
+                {
+                    continue;
+                }
+                record.state.store(FC_IDLE, std::memory_order_release);
+                applied = true;
+            }
+            if(!applied)
+            {
+                break;
+            }
+        }
+        reclaimer.retireBatch(dequeued, threadID);
+        reclaimer.end(threadID);
+    }
+
+    bool tryLock()
+    {
+        return !lock.load(std::memory_order_relaxed) && !lock.exchange(true, std::memory_order_acquire);
+    }
+
+    // Posts the operation and waits until some combiner, possibly this
+    // thread, has applied it. Waiters yield now and then so a preempted
+    // combiner gets to run when there are more threads than cores.
+    T* apply(int op, T* item, int threadID)
+    {
+        if(threadID < 0 || threadID >= numOfThreads)
+        {
+            throw std::out_of_range("FlatCombiningQueue: thread id out of range");
+        }
+        Record& record = records[threadID];
+        record.item = item;
+        record.state.store(op, std::memory_order_release);
+        for(int spins = 1; ; spins++)
+        {
+            if(tryLock())
+            {
+                combine(threadID);
+                lock.store(false, std::memory_order_release);
+            }
+            if(record.state.load(std::memory_order_acquire) == FC_IDLE)
+            {
+                return record.item;
+            }
+            if(spins % FC_SPINS_BEFORE_YIELD == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+
+    FlatCombiningQueue(int numOfThreads) : numOfThreads{checkThreads(numOfThreads)} {
+        Node* sentinel = reclaimer.alloc(new Node(nullptr), 0);
+        head = sentinel;
+        tail = sentinel;
+    }
+
+    ~FlatCombiningQueue(){
+        while(head != nullptr)
+        {
+            Node* next = head->next;
+            delete head;
+            head = next;
+        }
+    }
+
+    bool enqueue(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        apply(FC_ENQUEUE, item, threadID);
+        parking.notify();
+        return true;
+    }
+
+    T* dequeue(int threadID)
+    {
+        return apply(FC_DEQUEUE, nullptr, threadID);
+    }
+
+    // Like dequeue, but parks on an empty queue until an item arrives or
+    // timeout has passed, when it returns nullptr
+    T* dequeueWait(int threadID, std::chrono::nanoseconds timeout)
+    {
+        return parking.wait([&] { return dequeue(threadID); }, timeout);
+    }
+
+    bool enqueue(T* item, const ThreadContext& context) { return enqueue(item, context.id(numOfThreads)); }
+
+    T* dequeue(const ThreadContext& context) { return dequeue(context.id(numOfThreads)); }
+
+    T* dequeueWait(const ThreadContext& context, std::chrono::nanoseconds timeout) { return dequeueWait(context.id(numOfThreads), timeout); }
+
+    bool enqueue(T* item) { return enqueue(item, ThreadContext::current()); }
+
+    T* dequeue() { return dequeue(ThreadContext::current()); }
+
+    T* dequeueWait(std::chrono::nanoseconds timeout) { return dequeueWait(ThreadContext::current(), timeout); }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return reclaimer.retiredCount(threadID);
+    }
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef HUGE_PAGE_ARENA_HPP
+#define HUGE_PAGE_ARENA_HPP
+
+#include <mutex>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <sys/mman.h>
+
+#define HUGE_PAGE_SIZE (2UL * 1024 * 1024)
+#define HUGE_PAGE_ARENA_REGION (64UL * 1024 * 1024)
+
+// Process-wide arena of large anonymous mappings, aligned to and advised for
+// 2MB transparent huge pages. Where the kernel has them disabled the advice
+// is ignored and the region is simply backed by 4K pages. Chunks are carved
+// sequentially with a bump pointer, so memory handed out close in time is
+// close in the address space, and are never given back: the allocators
+// recycle what they carve.
+class HugePageArena {
+private:
+    std::mutex lock;
+    char* next{nullptr};
+    char* end{nullptr};
+
+    HugePageArena() { }
+
+    // Over-reserves by a huge page and trims both ends so the region starts
+    // on a huge page boundary
+    static char* mapRegion(size_t size)
+    {
+        size_t reserve = size + HUGE_PAGE_SIZE;
+        void* raw = mmap(nullptr, reserve, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        uintptr_t start = ((uintptr_t)raw + HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1);
+        size_t head = start - (uintptr_t)raw;
+        if (head > 0) {
+            munmap(raw, head);
+        }
+        size_t tail = reserve - head - size;
+        if (tail > 0) {
+            munmap((char*)start + size, tail);
+        }
+#ifdef MADV_HUGEPAGE
+        madvise((void*)start, size, MADV_HUGEPAGE);
+#endif
+        return (char*)start;
+    }
+
+public:
+    static HugePageArena& global()
+    {
+        static HugePageArena* arena = new HugePageArena();
+        return *arena;
+    }
+
+    void* allocate(size_t size)
+    {
+        size = (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        std::lock_guard<std::mutex> guard(lock);
+        char* chunk = next;
+        if (chunk == nullptr || chunk + size > end) {
+            size_t regionSize = size > HUGE_PAGE_ARENA_REGION ? (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1) : HUGE_PAGE_ARENA_REGION;
+            chunk = mapRegion(regionSize);
+            end = chunk + regionSize;
+        }
+        next = chunk + size;
+        return chunk;
+    }
+};
+
+#endif
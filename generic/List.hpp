@@ -0,0 +1,211 @@
+#ifndef GENERIC_LIST_HPP
+#define GENERIC_LIST_HPP
+
+#include <atomic>
+#include <iostream>
+#include "Reclaimers.hpp"
+#include "Allocators.hpp"
+#include "ThreadContext.hpp"
+
+// Harris-Michael sorted list, written once for every reclaimer policy in
+// Reclaimers.hpp and node allocator in Allocators.hpp
+template<typename T, template<typename> class Reclaimer, template<typename> class Allocator = DEFAULT_NODE_ALLOCATOR>
+class List {
+
+private:
+    struct Node : NodeHeaderOf<Reclaimer>::type {
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* item) : item{item}, next{nullptr} { }
+
+        static void* operator new(size_t) { return Allocator<Node>::allocate(); }
+
+        static void operator delete(void* ptr) { Allocator<Node>::deallocate(ptr); }
+    };
+
+    bool isMarked(Node * node) {
+    	return ((size_t) node & 0x1);
+    }
+
+    Node * getMarked(Node * node) {
+    	return (Node*)((size_t) node | 0x1);
+    }
+
+    Node * getUnmarked(Node * node) {
+    	return (Node*)((size_t) node & (~0x1));
+    }
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    int numThreads;
+    Reclaimer<Node> reclaimer {numThreads};
+
+public:
+
+    List(int numThreads) : numThreads{numThreads}
+    {
+        Node* sentinel = reclaimer.alloc(new Node(nullptr), 0);
+        head.store(sentinel);
+        tail.store(sentinel);
+        head.load()->next.store(tail.load());
+    }
+
+    ~List()
+    {
+        Node* node = getUnmarked(head.load());
+        while(node != tail.load())
+        {
+            Node* next = getUnmarked(node->next.load());
+            delete node;
+            node = next;
+        }
+        delete tail.load();
+    }
+
+    bool add(T* item, int threadID)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        Node* node = reclaimer.alloc(new Node(item), threadID);
+        reclaimer.begin(threadID);
+        while (true) {
+            if (find(item, &pred, &curr, &next, threadID)) 
+            {
+                delete node;
+                reclaimer.end(threadID);
+                return false;
+            }
+            node->next.store(curr, std::memory_order_relaxed);
+            Node *temp = curr;
+            if (pred->compare_exchange_strong(temp, node)) 
+            {
+                reclaimer.end(threadID);
+                return true;
+            }
+        }
+    }
+
+    bool remove(T* item, int threadID)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        reclaimer.begin(threadID);
+        while (true) 
+        {
+            if (!find(item, &pred, &curr, &next, threadID)) {
+                reclaimer.end(threadID);
+                return false;
+            }
+            Node *temp = getUnmarked(next);
+            if (!curr->next.compare_exchange_strong(temp, getMarked(next))) {
+                continue;
+            }
+            temp = curr;
+            if (pred->compare_exchange_strong(temp, getUnmarked(next))) 
+            {
+                reclaimer.retire(curr, threadID);
+            }
+            reclaimer.end(threadID);
+            return true;
+        }
+    }
+
+    bool contains (T* item, int threadID)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        reclaimer.begin(threadID);
+        bool found = find(item, &pred, &curr, &next, threadID);
+        reclaimer.end(threadID);
+        return found;
+    }
+
+    bool add(T* item, const ThreadContext& context) { return add(item, context.id(numThreads)); }
+
+    bool remove(T* item, const ThreadContext& context) { return remove(item, context.id(numThreads)); }
+
+    bool contains(T* item, const ThreadContext& context) { return contains(item, context.id(numThreads)); }
+
+    bool add(T* item) { return add(item, ThreadContext::current()); }
+
+    bool remove(T* item) { return remove(item, ThreadContext::current()); }
+
+    bool contains(T* item) { return contains(item, ThreadContext::current()); }
+
+    uint64_t getRetiredCountLinkedList(int threadID)
+    {
+        return reclaimer.retiredCount(threadID);
+    }
+
+
+private:
+
+    // Runs inside the caller's begin/end. The three protection slots rotate
+    // between next, curr and pred's node as the traversal advances, so a
+    // node never has to be copied from one slot to another. Checking that
+    // pred still points at curr after protecting next is what makes next
+    // safe for slot-based reclaimers. curr is always unmarked.
+    bool find (T* item, std::atomic<Node*> **par_pred, Node **par_curr, Node **par_next, const int threadID)
+    {
+        std::atomic<Node*> *pred;
+        Node *curr, *next;
+        int nextSlot, currSlot, predSlot;
+     try_again:
+        next = nullptr;
+        nextSlot = 0;
+        currSlot = 1;
+        predSlot = 2;
+        pred = &head;
+        curr = reclaimer.protect(currSlot, head, threadID);
+        while (true) {
+            if (curr == nullptr) 
+            {
+                break;
+            }
+            next = reclaimer.protect(nextSlot, curr->next, threadID);
+            if (pred->load() != curr) 
+            {
+                goto try_again;
+            }
+            if (getUnmarked(next) == tail.load()) 
+            {
+                break;
+            }
+            if (!isMarked(next)) 
+            {
+                if (curr->item != nullptr && !(*curr->item < *item)) 
+                {
+                    *par_curr = curr;
+                    *par_pred = pred;
+                    *par_next = next;
+                    return (*curr->item == *item);
+                }
+                pred = &curr->next;
+                int freeSlot = predSlot;
+                predSlot = currSlot;
+                currSlot = nextSlot;
+                nextSlot = freeSlot;
+            } 
+            else 
+            {
+                Node *temp = curr;
+                if (!pred->compare_exchange_strong(temp, getUnmarked(next))) 
+                {
+                    goto try_again;
+                }
+                reclaimer.retire(curr, threadID);
+                int freeSlot = currSlot;
+                currSlot = nextSlot;
+                nextSlot = freeSlot;
+            }
+            curr = getUnmarked(next);
+        }
+        *par_curr = curr;
+        *par_pred = pred;
+        *par_next = next;
+        return false;
+    }
+};
+
+#endif
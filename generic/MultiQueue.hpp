@@ -0,0 +1,246 @@
+#ifndef GENERIC_MULTI_QUEUE_HPP
+#define GENERIC_MULTI_QUEUE_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <climits>
+#include "Queue.hpp"
+
+#define MULTIQUEUE_LANES_PER_THREAD 2
+#define MULTIQUEUE_EMPTY_STAMP UINT64_MAX
+
+// Relaxed FIFO queue (MultiQueue, Rihani, Sanders and Dementiev) made of
+// MULTIQUEUE_LANES_PER_THREAD Michael-Scott lanes per thread, the
+// MichaelScottLane that Queue is built on. Every node carries the
+// steady_clock time of its enqueue. Enqueue links into one random lane;
+// dequeue reads the stamps at the heads of two random lanes and takes from
+// the older, which is what keeps the expected rank error, how many items
+// enqueued earlier are still in the queue, at O(lanes). Stamps are read
+// before the node is linked, so within a lane they are only roughly ordered
+// under contention and the bound is up to that skew. A dequeue whose lane
+// turns out empty tries every lane before it returns nullptr.
+//
+// All lanes share one reclaimer, so unreclaimed nodes are bounded as for a
+// single queue rather than once per lane.
+template<typename T, template<typename> class Reclaimer, template<typename> class Allocator = QUEUE_NODE_ALLOCATOR>
+class MultiQueue
+{
+
+private:
+    struct Node : NodeHeaderOf<Reclaimer>::type {
+        T* item;
+        uint64_t stamp;
+        std::atomic<Node*> next;
+
+        Node(T* item, uint64_t stamp) : item{item}, stamp{stamp}, next{nullptr} { }
+
+        static void* operator new(size_t) { return Allocator<Node>::allocate(); }
+
+        static void operator delete(void* ptr) { Allocator<Node>::deallocate(ptr); }
+
+        bool casNext(Node *cmp, Node *val) {
+            return next.compare_exchange_strong(cmp, val);
+        }
+    };
+
+    struct alignas(64) Lane : MichaelScottLane<T, Node, Reclaimer<Node>> { };
+
+    const int numOfThreads;
+    Reclaimer<Node> reclaimer{numOfThreads};
+    std::vector<Lane> lanes;
+    ParkingLot parking;
+
+    static int numLanes(int numOfThreads)
+    {
+        int count = numOfThreads * MULTIQUEUE_LANES_PER_THREAD;
+        return count < 2 ? 2 : count;
+    }
+
+    static uint64_t now()
+    {
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    int randomLane()
+    {
+        static thread_local uint64_t seed = (uint64_t)(uintptr_t)&seed | 1;
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed % lanes.size();
+    }
+
+    // Enqueue time of the lane's oldest item, MULTIQUEUE_EMPTY_STAMP if it
+    // has none
+    uint64_t headStamp(Lane& lane, int threadID)
+    {
+        reclaimer.begin(threadID);
+        Node* first = lane.first(reclaimer, threadID);
+        uint64_t stamp = first == nullptr ? MULTIQUEUE_EMPTY_STAMP : first->stamp;
+        reclaimer.end(threadID);
+        return stamp;
+    }
+
+    // The older of two random lanes
+    Lane& pickLane(int threadID)
+    {
+        Lane& first = lanes[randomLane()];
+        Lane& second = lanes[randomLane()];
+        return headStamp(first, threadID) <= headStamp(second, threadID) ? first : second;
+    }
+
+public:
+
+    MultiQueue(int numOfThreads) : numOfThreads{numOfThreads}, lanes(numLanes(numOfThreads))
+    {
+        for(auto& lane : lanes)
+        {
+            lane.init(reclaimer.alloc(new Node(nullptr, 0), 0));
+        }
+    }
+
+    ~MultiQueue()
+    {
+        for(auto& lane : lanes)
+        {
+            lane.destroy();
+        }
+    }
+
+    bool enqueue(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = reclaimer.alloc(new Node(item, now()), threadID);
+        lanes[randomLane()].enqueueChain(node, node, reclaimer, threadID);
+        parking.notify();
+        return true;
+    }
+
+    T* dequeue(int threadID)
+    {
+        T* item = pickLane(threadID).dequeue(reclaimer, threadID);
+        if(item == nullptr)
+        {
+            int start = randomLane();
+            for(size_t i = 0; i < lanes.size() && item == nullptr; i++)
+            {
+                item = lanes[(start + i) % lanes.size()].dequeue(reclaimer, threadID);
+            }
+        }
+        return item;
+    }
+
+    // Links the items into one chain with a single stamp and appends it to
+    // one random lane, so they stay in order among themselves. Null items
+    // are skipped.
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last, int threadID)
+    {
+        uint64_t stamp = now();
+        Node* chainFirst = nullptr;
+        Node* chainLast = nullptr;
+        int count = 0;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = reclaimer.alloc(new Node(*first, stamp), threadID);
+            if(chainLast == nullptr)
+            {
+                chainFirst = node;
+            }
+            else
+            {
+                chainLast->next.store(node, std::memory_order_relaxed);
+            }
+            chainLast = node;
+            count++;
+        }
+        if(chainFirst == nullptr)
+        {
+            return false;
+        }
+        lanes[randomLane()].enqueueChain(chainFirst, chainLast, reclaimer, threadID);
+        parking.notify(count);
+        return true;
+    }
+
+    // Up to n items from the front of the older of two random lanes, or of
+    // the first non-empty lane if that one is empty
+    int dequeueBatch(int n, T** out, int threadID)
+    {
+        std::vector<T*> items;
+        pickLane(threadID).dequeueChain(n, items, reclaimer, threadID);
+        int start = randomLane();
+        for(size_t i = 0; i < lanes.size() && items.empty(); i++)
+        {
+            lanes[(start + i) % lanes.size()].dequeueChain(n, items, reclaimer, threadID);
+        }
+        for(size_t i = 0; i < items.size(); i++)
+        {
+            out[i] = items[i];
+        }
+        return (int)items.size();
+    }
+
+    // Every lane up to the tail seen while walking it, lane by lane
+    std::vector<T*> drain(int threadID)
+    {
+        std::vector<T*> items;
+        std::vector<T*> laneItems;
+        for(auto& lane : lanes)
+        {
+            lane.dequeueChain(INT_MAX, laneItems, reclaimer, threadID);
+            items.insert(items.end(), laneItems.begin(), laneItems.end());
+        }
+        return items;
+    }
+
+    // Like dequeue, but parks on an empty queue until an item arrives or
+    // timeout has passed, when it returns nullptr
+    T* dequeueWait(int threadID, std::chrono::nanoseconds timeout)
+    {
+        return parking.wait([&] { return dequeue(threadID); }, timeout);
+    }
+
+    bool enqueue(T* item, const ThreadContext& context) { return enqueue(item, context.id(numOfThreads)); }
+
+    T* dequeue(const ThreadContext& context) { return dequeue(context.id(numOfThreads)); }
+
+    T* dequeueWait(const ThreadContext& context, std::chrono::nanoseconds timeout) { return dequeueWait(context.id(numOfThreads), timeout); }
+
+    bool enqueue(T* item) { return enqueue(item, ThreadContext::current()); }
+
+    T* dequeue() { return dequeue(ThreadContext::current()); }
+
+    T* dequeueWait(std::chrono::nanoseconds timeout) { return dequeueWait(ThreadContext::current(), timeout); }
+
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last, const ThreadContext& context) { return enqueueBatch(first, last, context.id(numOfThreads)); }
+
+    int dequeueBatch(int n, T** out, const ThreadContext& context) { return dequeueBatch(n, out, context.id(numOfThreads)); }
+
+    std::vector<T*> drain(const ThreadContext& context) { return drain(context.id(numOfThreads)); }
+
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last) { return enqueueBatch(first, last, ThreadContext::current()); }
+
+    int dequeueBatch(int n, T** out) { return dequeueBatch(n, out, ThreadContext::current()); }
+
+    std::vector<T*> drain() { return drain(ThreadContext::current()); }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return reclaimer.retiredCount(threadID);
+    }
+};
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef PARKING_LOT_HPP
+#define PARKING_LOT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+// Where consumers of an empty queue park, used by the queues' dequeueWait.
+// A consumer counts itself in waiters before its last look at the queue and
+// parks on sequence, a futex word, only if that look finds nothing. A
+// producer checks waiters after its enqueue and bumps sequence and wakes
+// someone only when it is non-zero, so enqueue stays free of syscalls while
+// nobody is parked. Both sides are sequentially consistent, so either the
+// producer sees the waiter or the waiter's look sees the item; a bump that
+// lands between the consumer reading sequence and parking makes the futex
+// wait return at once.
+//
+// Outside Linux the same protocol runs on a mutex and condition variable.
+class ParkingLot {
+private:
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<int> waiters{0};
+#ifndef __linux__
+    std::mutex lock;
+    std::condition_variable parked;
+#endif
+
+    void park(uint32_t seen, std::chrono::nanoseconds timeout)
+    {
+#ifdef __linux__
+        struct timespec ts;
+        ts.tv_sec = (time_t)(timeout.count() / 1000000000);
+        ts.tv_nsec = (long)(timeout.count() % 1000000000);
+        syscall(SYS_futex, (uint32_t*)&sequence, FUTEX_WAIT_PRIVATE, seen, &ts, nullptr, 0);
+#else
+        std::unique_lock<std::mutex> guard(lock);
+        parked.wait_for(guard, timeout, [&] { return sequence.load() != seen; });
+#endif
+    }
+
+    void wake(int count)
+    {
+#ifdef __linux__
+        syscall(SYS_futex, (uint32_t*)&sequence, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+        std::lock_guard<std::mutex> guard(lock);
+        if (count == 1) {
+            parked.notify_one();
+        } else {
+            parked.notify_all();
+        }
+#endif
+    }
+
+public:
+    // After count items have been enqueued
+    void notify(int count = 1)
+    {
+        if (waiters.load() == 0) {
+            return;
+        }
+        sequence.fetch_add(1);
+        wake(count);
+    }
+
+    // Calls tryDequeue until it returns an item or timeout has passed,
+    // parking in between. Returns nullptr on timeout.
+    template<typename TryDequeue>
+    auto wait(TryDequeue tryDequeue, std::chrono::nanoseconds timeout) -> decltype(tryDequeue())
+    {
+        auto item = tryDequeue();
+        if (item != nullptr) {
+            return item;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (true) {
+            uint32_t seen = sequence.load();
+            waiters.fetch_add(1);
+            item = tryDequeue();
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if (item != nullptr || remaining <= std::chrono::nanoseconds::zero()) {
+                waiters.fetch_sub(1);
+                return item;
+            }
+            park(seen, std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+            waiters.fetch_sub(1);
+            item = tryDequeue();
+            if (item != nullptr) {
+                return item;
+            }
+        }
+    }
+};
+
+#endif
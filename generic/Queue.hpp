@@ -0,0 +1,323 @@
+#ifndef GENERIC_QUEUE_HPP
+#define GENERIC_QUEUE_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include <climits>
+#include "Reclaimers.hpp"
+#include "Allocators.hpp"
+#include "ThreadContext.hpp"
+#include "ParkingLot.hpp"
+
+// Head and tail of one Michael-Scott queue and the operations on them,
+// written against a reclaimer the caller owns. Queue is one lane with its
+// own reclaimer; MultiQueue drives many lanes from a single reclaimer. Node
+// provides item, an atomic next and casNext. Slot 0 holds the head or tail
+// node, slot 1 its successor; batch dequeues walk with slots 1 and 2.
+template<typename T, typename Node, typename Reclaimer>
+struct MichaelScottLane
+{
+    std::atomic<Node*> head{nullptr};
+    std::atomic<Node*> tail{nullptr};
+
+    void init(Node* sentinel)
+    {
+        head.store(sentinel, std::memory_order_relaxed);
+        tail.store(sentinel, std::memory_order_relaxed);
+    }
+
+    // Frees the nodes still linked; no other thread may be using the lane
+    void destroy()
+    {
+        Node* node = head.load();
+        while(node != nullptr)
+        {
+            Node* next = node->next.load();
+            delete node;
+            node = next;
+        }
+    }
+
+    // Appends the chain first..last, already linked through next, with one
+    // CAS on the last node's next and then swings tail to its end
+    void enqueueChain(Node* first, Node* last, Reclaimer& reclaimer, int threadID)
+    {
+        reclaimer.begin(threadID);
+        while(true)
+        {
+            Node* temp = reclaimer.protect(0, tail, threadID);
+            Node* next = temp->next.load();
+            if (temp == tail.load()) 
+            {
+                if (next == nullptr) 
+                {
+                    if (temp->casNext(nullptr, first)) 
+                    {
+                        tail.compare_exchange_strong(temp, last);
+                        reclaimer.end(threadID);
+                        return;
+                    }
+                } 
+                else 
+                {
+                    tail.compare_exchange_strong(temp, next);
+                }
+            }
+        }
+    }
+
+    // A head equal to tail with a successor means the enqueuer that linked
+    // it has not swung tail yet; the dequeuer swings it and retries rather
+    // than report an empty lane
+    T* dequeue(Reclaimer& reclaimer, int threadID)
+    {
+        reclaimer.begin(threadID);
+        while (true) 
+        {
+            Node* node = reclaimer.protect(0, head, threadID);
+            Node* next = reclaimer.protect(1, node->next, threadID);
+            if (head.load() != node) 
+            {
+                continue;
+            }
+            if (next == nullptr) 
+            {
+                reclaimer.end(threadID);
+                return nullptr;
+            }
+            Node* last = tail.load();
+            if (node == last)
+            {
+                tail.compare_exchange_strong(last, next);
+                continue;
+            }
+            if (head.compare_exchange_strong(node, next)) 
+            {
+                T* item = next->item;
+                reclaimer.retire(node, threadID);
+                reclaimer.end(threadID);
+                return item;
+            }
+        }
+    }
+
+    // The oldest node, nullptr if the lane is empty. Call it between the
+    // reclaimer's begin and end; the node stays protected until then.
+    Node* first(Reclaimer& reclaimer, int threadID)
+    {
+        while (true)
+        {
+            Node* node = reclaimer.protect(0, head, threadID);
+            Node* next = reclaimer.protect(1, node->next, threadID);
+            if (head.load() == node)
+            {
+                return next;
+            }
+        }
+    }
+
+    // Walks up to n nodes past head, never past tail, and moves head to the
+    // last of them with one CAS; the nodes it passed are retired with one
+    // call. A node reached on the walk is safe once it is protected while
+    // head is still unchanged, because nodes are only retired after head has
+    // moved past them.
+    void dequeueChain(int n, std::vector<T*>& items, Reclaimer& reclaimer, int threadID)
+    {
+        std::vector<Node*> detached;
+        reclaimer.begin(threadID);
+        while(true)
+        {
+            items.clear();
+            Node* node = reclaimer.protect(0, head, threadID);
+            Node* last = node;
+            int slot = 1;
+            bool moved = false;
+            while((int)items.size() < n && last != tail.load())
+            {
+                Node* next = reclaimer.protect(slot, last->next, threadID);
+                if(head.load() != node)
+                {
+                    moved = true;
+                    break;
+                }
+                if(next == nullptr)
+                {
+                    break;
+                }
+                items.push_back(next->item);
+                last = next;
+                slot = 3 - slot;
+            }
+            if(moved)
+            {
+                continue;
+            }
+            if(last == node)
+            {
+                break;
+            }
+            if(head.compare_exchange_strong(node, last))
+            {
+                for(Node* cur = node; cur != last; cur = cur->next.load(std::memory_order_relaxed))
+                {
+                    detached.push_back(cur);
+                }
+                break;
+            }
+        }
+        reclaimer.retireBatch(detached, threadID);
+        reclaimer.end(threadID);
+    }
+};
+
+// Michael-Scott queue, written once for every reclaimer policy in
+// Reclaimers.hpp and node allocator in Allocators.hpp, as a single
+// MichaelScottLane with its own reclaimer.
+template<typename T, template<typename> class Reclaimer, template<typename> class Allocator = QUEUE_NODE_ALLOCATOR>
+class Queue
+{
+
+private:
+    struct Node : NodeHeaderOf<Reclaimer>::type {
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* item) : item{item}, next{nullptr} { }
+
+        static void* operator new(size_t) { return Allocator<Node>::allocate(); }
+
+        static void operator delete(void* ptr) { Allocator<Node>::deallocate(ptr); }
+
+        bool casNext(Node *cmp, Node *val) {
+            return next.compare_exchange_strong(cmp, val);
+        }
+    };
+
+    const int numOfThreads;
+    Reclaimer<Node> reclaimer{numOfThreads};
+    MichaelScottLane<T, Node, Reclaimer<Node>> lane;
+    ParkingLot parking;
+
+public:
+
+    Queue(int numOfThreads) : numOfThreads{numOfThreads} {
+        lane.init(reclaimer.alloc(new Node(nullptr), 0));
+    }
+
+    ~Queue(){
+        lane.destroy();
+    }
+
+    bool enqueue(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = reclaimer.alloc(new Node(item), threadID);
+        lane.enqueueChain(node, node, reclaimer, threadID);
+        parking.notify();
+        return true;
+    }
+
+    T* dequeue(int threadID)
+    {
+        return lane.dequeue(reclaimer, threadID);
+    }
+
+    // Links the items into a private chain, appends it with one CAS on the
+    // last node's next and then swings tail to the end of the chain. Null
+    // items are skipped.
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last, int threadID)
+    {
+        Node* chainFirst = nullptr;
+        Node* chainLast = nullptr;
+        int count = 0;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = reclaimer.alloc(new Node(*first), threadID);
+            if(chainLast == nullptr)
+            {
+                chainFirst = node;
+            }
+            else
+            {
+                chainLast->next.store(node, std::memory_order_relaxed);
+            }
+            chainLast = node;
+            count++;
+        }
+        if(chainFirst == nullptr)
+        {
+            return false;
+        }
+        lane.enqueueChain(chainFirst, chainLast, reclaimer, threadID);
+        parking.notify(count);
+        return true;
+    }
+
+    int dequeueBatch(int n, T** out, int threadID)
+    {
+        std::vector<T*> items;
+        lane.dequeueChain(n, items, reclaimer, threadID);
+        for(size_t i = 0; i < items.size(); i++)
+        {
+            out[i] = items[i];
+        }
+        return (int)items.size();
+    }
+
+    // Everything up to the tail seen while walking, with one CAS on head
+    std::vector<T*> drain(int threadID)
+    {
+        std::vector<T*> items;
+        lane.dequeueChain(INT_MAX, items, reclaimer, threadID);
+        return items;
+    }
+
+    // Like dequeue, but parks on an empty queue until an item arrives or
+    // timeout has passed, when it returns nullptr
+    T* dequeueWait(int threadID, std::chrono::nanoseconds timeout)
+    {
+        return parking.wait([&] { return dequeue(threadID); }, timeout);
+    }
+
+    bool enqueue(T* item, const ThreadContext& context) { return enqueue(item, context.id(numOfThreads)); }
+
+    T* dequeue(const ThreadContext& context) { return dequeue(context.id(numOfThreads)); }
+
+    T* dequeueWait(const ThreadContext& context, std::chrono::nanoseconds timeout) { return dequeueWait(context.id(numOfThreads), timeout); }
+
+    bool enqueue(T* item) { return enqueue(item, ThreadContext::current()); }
+
+    T* dequeue() { return dequeue(ThreadContext::current()); }
+
+    T* dequeueWait(std::chrono::nanoseconds timeout) { return dequeueWait(ThreadContext::current(), timeout); }
+
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last, const ThreadContext& context) { return enqueueBatch(first, last, context.id(numOfThreads)); }
+
+    int dequeueBatch(int n, T** out, const ThreadContext& context) { return dequeueBatch(n, out, context.id(numOfThreads)); }
+
+    std::vector<T*> drain(const ThreadContext& context) { return drain(context.id(numOfThreads)); }
+
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last) { return enqueueBatch(first, last, ThreadContext::current()); }
+
+    int dequeueBatch(int n, T** out) { return dequeueBatch(n, out, ThreadContext::current()); }
+
+    std::vector<T*> drain() { return drain(ThreadContext::current()); }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return reclaimer.retiredCount(threadID);
+    }
+};
+
+#endif
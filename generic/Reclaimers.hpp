@@ -0,0 +1,304 @@
+#ifndef RECLAIMERS_HPP
+#define RECLAIMERS_HPP
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include "../hazardpointer/hazardpointer.hpp"
+#include "../hazarderas/hazarderas.hpp"
+#include "../intervalbasedrec/IntervalBasedReclamation.hpp"
+#include "../urcu/URCU.hpp"
+#include "ThreadContext.hpp"
+#include "SharedHazardDomain.hpp"
+
+#define RECLAIMER_IBR_EPOCH_FREQUENCY 150
+#define RECLAIMER_IBR_RECLAIM_FREQUENCY 30
+
+// Policies plugged into Stack, Queue and List. A reclaimer for node type
+// Node provides:
+//
+//   Reclaimer(int numThreads)
+//   Node* alloc(Node* node, int tid)     stamp a new node before it is shared
+//   void begin(int tid)                  start of an operation
+//   Node* protect(int index, const std::atomic<Node*>& src, int tid)
+//                                        read src so the node stays safe to
+//                                        dereference until end or until slot
+//                                        index is reused; bit 0 is a mark and
+//                                        is kept in the returned value
+//   void retire(Node* node, int tid)     node has been unlinked
+//   void retireBatch(const std::vector<Node*>& nodes, int tid)
+//                                        several nodes unlinked at once,
+//                                        reclaimed with a single scan
+//   void end(int tid)                    end of an operation
+//   uint64_t retiredCount(int tid)       retired but not yet freed
+//
+// The domains behind HP, HE and IBR have a fixed number of per-thread rows
+// and index them by tid unchecked, so their policies refuse a thread count
+// above it when the container is built.
+//
+// Everything is resolved at compile time. Per-node bookkeeping comes from
+// NodeHeaderOf<Reclaimer>::type, which the containers' nodes derive from.
+
+inline int checkReclaimerThreads(int numThreads, int rows, const char* policy)
+{
+    if (numThreads > rows)
+    {
+        throw std::runtime_error(std::string(policy) + ": more threads than the domain has rows (" + std::to_string(rows) + ")");
+    }
+    return numThreads;
+}
+
+template<template<typename> class Reclaimer>
+struct NodeHeaderOf {
+    struct type { };
+};
+
+template<typename Node>
+class HazardPointerReclaimer {
+private:
+    hazardPointers<Node> hp;
+
+public:
+    HazardPointerReclaimer(int numThreads) : hp{checkReclaimerThreads(numThreads, MAX_NUMBER_OF_THREADS, "HazardPointerReclaimer")} { }
+
+    Node* alloc(Node* node, int) { return node; }
+
+    void begin(int) { }
+
+    Node* protect(int index, const std::atomic<Node*>& src, int tid)
+    {
+        Node* ptr = src.load();
+        while (true)
+        {
+            hp.storeHazardPtr(index, (Node*)((size_t)ptr & ~0x1), tid);
+            Node* again = src.load();
+            if (again == ptr)
+            {
+                return ptr;
+            }
+            ptr = again;
+        }
+    }
+
+    void retire(Node* node, int tid) { hp.retireNode(node, tid); }
+
+    void retireBatch(const std::vector<Node*>& nodes, int tid) { hp.retireNodes(nodes, tid); }
+
+    void end(int tid) { hp.clear(tid); }
+
+    uint64_t retiredCount(int tid) { return hp.getRetiredCount(tid); }
+};
+
+// Hazard pointers from the process-wide SharedHazardDomain instead of a
+// domain per container, so containers cost no slot arrays of their own and
+// all of them are reclaimed by one scan. The tid containers pass in is only
+// unique within one container, so the domain is indexed by the calling
+// thread's ThreadContext id instead and the tid arguments are ignored.
+template<typename Node>
+class SharedHazardPointerReclaimer {
+private:
+    SharedHazardDomain& domain;
+
+    static void deleteNode(void* ptr) { delete static_cast<Node*>(ptr); }
+
+    static int row() { return ThreadContext::current().id(); }
+
+public:
+    SharedHazardPointerReclaimer(int) : domain{SharedHazardDomain::global()} { }
+
+    Node* alloc(Node* node, int) { return node; }
+
+    void begin(int) { domain.enter(); }
+
+    Node* protect(int index, const std::atomic<Node*>& src, int) { return domain.protect(index, src, row()); }
+
+    void retire(Node* node, int) { domain.retire(node, &deleteNode, row()); }
+
+    // The domain already scans once per batch of retires
+    void retireBatch(const std::vector<Node*>& nodes, int)
+    {
+        int tid = row();
+        for (auto node : nodes)
+        {
+            domain.retire(node, &deleteNode, tid);
+        }
+    }
+
+    void end(int) { domain.clear(row()); }
+
+    // The domain counts per thread, not per container id, so its total is
+    // reported under id 0 and summing over a container's ids comes out right
+    uint64_t retiredCount(int tid) { return tid == 0 ? domain.getRetiredCount() : 0; }
+};
+
+struct EraNodeHeader {
+    uint64_t newEra = 0;
+    uint64_t delEra = 0;
+};
+
+template<typename Node>
+class HazardErasReclaimer {
+private:
+    hazardEras<Node> he;
+
+public:
+    HazardErasReclaimer(int numThreads) : he{checkReclaimerThreads(numThreads, HE_MAX_NUMBER_OF_THREADS, "HazardErasReclaimer")} { }
+
+    Node* alloc(Node* node, int)
+    {
+        node->newEra = he.getEra();
+        return node;
+    }
+
+    void begin(int) { }
+
+    Node* protect(int index, const std::atomic<Node*>& src, int tid) { return he.get_protected(index, src, tid); }
+
+    void retire(Node* node, int tid) { he.retireNode(node, tid); }
+
+    void retireBatch(const std::vector<Node*>& nodes, int tid) { he.retireNodes(nodes, tid); }
+
+    void end(int tid) { he.clear(tid); }
+
+    uint64_t retiredCount(int tid) { return he.getRetiredNodeCount(tid); }
+};
+
+template<>
+struct NodeHeaderOf<HazardErasReclaimer> {
+    using type = EraNodeHeader;
+};
+
+struct EpochNodeHeader {
+    uint64_t birth_epoch = 0;
+    uint64_t retire_epoch = 0;
+};
+
+template<typename Node>
+class IBRReclaimer {
+private:
+    IntervalBasedReclamation<Node> ibr;
+
+public:
+    IBRReclaimer(int numThreads) : ibr{checkReclaimerThreads(numThreads, MAX_NUMBER_OF_THREADS_IBR, "IBRReclaimer"), RECLAIMER_IBR_EPOCH_FREQUENCY, RECLAIMER_IBR_RECLAIM_FREQUENCY} { }
+
+    Node* alloc(Node* node, int tid) { return ibr.allocNode(tid, node); }
+
+    void begin(int tid) { ibr.start_op(tid); }
+
+    Node* protect(int, const std::atomic<Node*>& src, int) { return src.load(); }
+
+    void retire(Node* node, int tid) { ibr.retireNode(node, tid); }
+
+    void retireBatch(const std::vector<Node*>& nodes, int tid) { ibr.retireNodes(nodes, tid); }
+
+    void end(int tid) { ibr.end_op(tid); }
+
+    uint64_t retiredCount(int tid) { return ibr.getRetiredNodeCount(tid); }
+};
+
+template<>
+struct NodeHeaderOf<IBRReclaimer> {
+    using type = EpochNodeHeader;
+};
+
+// Never frees a node while the container is alive, like the baseline
+// containers' LeakReclamation. A container instantiated with it is the
+// no-reclamation baseline for that same algorithm and node allocator, so
+// comparing against it isolates the cost of the reclaimer.
+template<typename Node>
+class LeakReclaimer {
+private:
+    std::vector<std::vector<Node*>> retired;
+
+public:
+    LeakReclaimer(int numThreads) : retired(numThreads) { }
+
+    ~LeakReclaimer()
+    {
+        for (auto& nodes : retired)
+        {
+            for (auto node : nodes)
+            {
+                delete node;
+            }
+        }
+    }
+
+    Node* alloc(Node* node, int) { return node; }
+
+    void begin(int) { }
+
+    Node* protect(int, const std::atomic<Node*>& src, int) { return src.load(); }
+
+    void retire(Node* node, int tid) { retired[tid].push_back(node); }
+
+    void retireBatch(const std::vector<Node*>& nodes, int tid) { retired[tid].insert(retired[tid].end(), nodes.begin(), nodes.end()); }
+
+    void end(int) { }
+
+    uint64_t retiredCount(int tid) { return retired[tid].size(); }
+};
+
+// Nodes retired during an operation are freed after a grace period once the
+// operation has left its read-side critical section, as the URCU containers
+// always did.
+template<typename Node>
+class URCUReclaimer {
+private:
+    URCU urcu;
+    std::vector<std::vector<Node*>> pending;
+    std::vector<uint64_t> retiredNodesCount;
+
+public:
+    URCUReclaimer(int numThreads) : urcu{numThreads}, pending(numThreads), retiredNodesCount(numThreads, 0) { }
+
+    ~URCUReclaimer()
+    {
+        for (auto& nodes : pending)
+        {
+            for (auto node : nodes)
+            {
+                delete node;
+            }
+        }
+    }
+
+    Node* alloc(Node* node, int) { return node; }
+
+    void begin(int tid) { urcu.readLock(tid); }
+
+    Node* protect(int, const std::atomic<Node*>& src, int) { return src.load(); }
+
+    void retire(Node* node, int tid)
+    {
+        pending[tid].push_back(node);
+        retiredNodesCount[tid] += 1;
+    }
+
+    void retireBatch(const std::vector<Node*>& nodes, int tid)
+    {
+        pending[tid].insert(pending[tid].end(), nodes.begin(), nodes.end());
+        retiredNodesCount[tid] += nodes.size();
+    }
+
+    void end(int tid)
+    {
+        urcu.readUnlock(tid);
+        if (pending[tid].empty())
+        {
+            return;
+        }
+        urcu.synchronizeRCU();
+        for (auto node : pending[tid])
+        {
+            delete node;
+        }
+        retiredNodesCount[tid] -= pending[tid].size();
+        pending[tid].clear();
+    }
+
+    uint64_t retiredCount(int tid) { return retiredNodesCount[tid]; }
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef SHARED_HAZARD_DOMAIN_HPP
+#define SHARED_HAZARD_DOMAIN_HPP
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include "ThreadContext.hpp"
+
+#define SHARED_HP_MAX_THREADS THREAD_CONTEXT_MAX_THREADS
+#define SHARED_HP_PER_THREAD 5
+#define SHARED_HP_SCAN_FACTOR 2
+
+// One process-wide set of hazard pointer slots and one retire pipeline for
+// every container and node type. Retired nodes are stored type-erased with
+// the deleter for their type, and a single scan covers the nodes of all
+// containers. A thread uses its slots for one operation at a time, so
+// operations on two containers sharing the domain must not be nested.
+//
+// Rows are indexed by the thread's process-wide ThreadRegistry id, never by
+// the dense per-container ids the containers are called with: two pools
+// using different containers hand out overlapping container ids, and would
+// share slots and retire lists if those indexed the domain.
+class SharedHazardDomain {
+
+private:
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    struct alignas(64) ThreadSlots {
+        std::atomic<void*> slots[SHARED_HP_PER_THREAD];
+    };
+
+    ThreadSlots hazards[SHARED_HP_MAX_THREADS];
+    std::vector<Retired> retiredList[SHARED_HP_MAX_THREADS];
+    uint64_t retiredCount[SHARED_HP_MAX_THREADS];
+    // One past the highest row ever used, so scans skip rows no thread has
+    std::atomic<int> activeThreads{0};
+
+    SharedHazardDomain()
+    {
+        for (int i = 0; i < SHARED_HP_MAX_THREADS; i++) {
+            for (int j = 0; j < SHARED_HP_PER_THREAD; j++) {
+                hazards[i].slots[j].store(nullptr, std::memory_order_relaxed);
+            }
+            retiredCount[i] = 0;
+        }
+    }
+
+    ~SharedHazardDomain()
+    {
+        for (int i = 0; i < SHARED_HP_MAX_THREADS; i++) {
+            for (auto& r : retiredList[i]) {
+                r.deleter(r.ptr);
+            }
+        }
+    }
+
+    void scan(const int tid)
+    {
+        int threads = activeThreads.load(std::memory_order_acquire);
+        std::vector<void*> protectedPtrs;
+        protectedPtrs.reserve(threads * SHARED_HP_PER_THREAD);
+        for (int i = 0; i < threads; i++) {
+            for (int j = 0; j < SHARED_HP_PER_THREAD; j++) {
+                void* ptr = hazards[i].slots[j].load();
+                if (ptr != nullptr) {
+                    protectedPtrs.push_back(ptr);
+                }
+            }
+        }
+        std::sort(protectedPtrs.begin(), protectedPtrs.end());
+        std::vector<Retired>& list = retiredList[tid];
+        size_t kept = 0;
+        for (size_t i = 0; i < list.size(); i++) {
+            if (std::binary_search(protectedPtrs.begin(), protectedPtrs.end(), list[i].ptr)) {
+                list[kept++] = list[i];
+                continue;
+            }
+            list[i].deleter(list[i].ptr);
+            retiredCount[tid] -= 1;
+        }
+        list.resize(kept);
+    }
+
+public:
+    static SharedHazardDomain& global()
+    {
+        static SharedHazardDomain domain;
+        return domain;
+    }
+
+    // The calling thread's row. Raising activeThreads before any slot of the
+    // row is published keeps the row inside every scan that could miss it.
+    int enter()
+    {
+        int tid = ThreadContext::current().id();
+        int current = activeThreads.load();
+        while (current <= tid && !activeThreads.compare_exchange_weak(current, tid + 1));
+        return tid;
+    }
+
+    void clear(const int tid)
+    {
+        for (int j = 0; j < SHARED_HP_PER_THREAD; j++) {
+            hazards[tid].slots[j].store(nullptr, std::memory_order_release);
+        }
+    }
+
+    template<typename Node>
+    Node* protect(int index, const std::atomic<Node*>& src, const int tid)
+    {
+        Node* ptr = src.load();
+        while (true) {
+            hazards[tid].slots[index].store((void*)((size_t)ptr & ~0x1));
+            Node* again = src.load();
+            if (again == ptr) {
+                return ptr;
+            }
+            ptr = again;
+        }
+    }
+
+    // Scans once the thread's list outgrows the number of slots in use, so
+    // each scan frees a constant fraction of what it looks at
+    void retire(void* ptr, void (*deleter)(void*), const int tid)
+    {
+        retiredList[tid].push_back(Retired{ptr, deleter});
+        retiredCount[tid] += 1;
+        if (retiredList[tid].size() >= (size_t)(SHARED_HP_SCAN_FACTOR * SHARED_HP_PER_THREAD * activeThreads.load(std::memory_order_relaxed))) {
+            scan(tid);
+        }
+    }
+
+    // Covers every container and every thread using the domain
+    uint64_t getRetiredCount()
+    {
+        uint64_t count = 0;
+        int threads = activeThreads.load(std::memory_order_acquire);
+        for (int i = 0; i < threads; i++) {
+            count += retiredCount[i];
+        }
+        return count;
+    }
+};
+
+#endif
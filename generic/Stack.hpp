@@ -0,0 +1,206 @@
+#ifndef GENERIC_STACK_HPP
+#define GENERIC_STACK_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "Reclaimers.hpp"
+#include "Allocators.hpp"
+#include "ThreadContext.hpp"
+
+// Treiber stack, written once for every reclaimer policy in Reclaimers.hpp
+// and node allocator in Allocators.hpp
+template<typename T, template<typename> class Reclaimer, template<typename> class Allocator = DEFAULT_NODE_ALLOCATOR>
+class Stack {
+private:
+    struct Node : NodeHeaderOf<Reclaimer>::type {
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* item) : item{item}, next{nullptr} { }
+
+        static void* operator new(size_t) { return Allocator<Node>::allocate(); }
+
+        static void operator delete(void* ptr) { Allocator<Node>::deallocate(ptr); }
+    };
+
+    std::atomic<Node*> top;
+    const int numOfThreads;
+    Reclaimer<Node> reclaimer{numOfThreads};
+
+public:
+
+    Stack(int numOfThreads) : numOfThreads{numOfThreads}
+    {
+        Node* sentinel = reclaimer.alloc(new Node(nullptr), 0);
+        top.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~Stack()
+    {
+        while(pop(0) != nullptr);
+        delete top.load();
+    }
+
+    bool push(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = reclaimer.alloc(new Node(item), threadID);
+        reclaimer.begin(threadID);
+        while(true)
+        {
+            Node* temp = top.load();
+            node->next.store(temp, std::memory_order_relaxed);
+            if(top.compare_exchange_strong(temp, node))
+            {
+                reclaimer.end(threadID);
+                return true;
+            }
+        }
+    }
+
+    T* pop(int threadID)
+    {
+        reclaimer.begin(threadID);
+        while(true)
+        {
+            Node* temp = reclaimer.protect(0, top, threadID);
+            if(temp == nullptr)
+            {
+                reclaimer.end(threadID);
+                return nullptr;
+            }
+            Node* next = temp->next.load();
+            if(top.compare_exchange_strong(temp, next))
+            {
+                T* ret_data = temp->item;
+                reclaimer.retire(temp, threadID);
+                reclaimer.end(threadID);
+                return ret_data;
+            }
+        }
+    }
+
+    // Links the items into a private chain and splices it onto top with one
+    // CAS, so the last item ends up on top. Null items are skipped.
+    template<typename Iterator>
+    bool pushBatch(Iterator first, Iterator last, int threadID)
+    {
+        Node* bottom = nullptr;
+        Node* chain = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = reclaimer.alloc(new Node(*first), threadID);
+            node->next.store(chain, std::memory_order_relaxed);
+            if(bottom == nullptr)
+            {
+                bottom = node;
+            }
+            chain = node;
+        }
+        if(chain == nullptr)
+        {
+            return false;
+        }
+        reclaimer.begin(threadID);
+        while(true)
+        {
+            Node* temp = top.load();
+            bottom->next.store(temp, std::memory_order_relaxed);
+            if(top.compare_exchange_strong(temp, chain))
+            {
+                reclaimer.end(threadID);
+                return true;
+            }
+        }
+    }
+
+    // Pops up to n items into out within one operation and retires the
+    // nodes with one call. Each node still takes its own CAS: the nodes below
+    // top may be popped and freed by other threads, so they cannot be walked
+    // to detach several at once. Stops, like pop, at the sentinel.
+    int popBatch(int n, T** out, int threadID)
+    {
+        std::vector<Node*> popped;
+        int count = 0;
+        reclaimer.begin(threadID);
+        while(count < n)
+        {
+            Node* temp = reclaimer.protect(0, top, threadID);
+            if(temp == nullptr)
+            {
+                break;
+            }
+            Node* next = temp->next.load();
+            if(top.compare_exchange_strong(temp, next))
+            {
+                popped.push_back(temp);
+                if(temp->item == nullptr)
+                {
+                    break;
+                }
+                out[count++] = temp->item;
+            }
+        }
+        reclaimer.retireBatch(popped, threadID);
+        reclaimer.end(threadID);
+        return count;
+    }
+
+    // Takes the whole stack with one exchange. The detached chain is then
+    // private, so it is walked without protection and retired with one call.
+    // Items come out in pop order.
+    std::vector<T*> popAll(int threadID)
+    {
+        std::vector<T*> items;
+        std::vector<Node*> nodes;
+        reclaimer.begin(threadID);
+        for(Node* node = top.exchange(nullptr); node != nullptr; node = node->next.load(std::memory_order_relaxed))
+        {
+            nodes.push_back(node);
+            if(node->item != nullptr)
+            {
+                items.push_back(node->item);
+            }
+        }
+        reclaimer.retireBatch(nodes, threadID);
+        reclaimer.end(threadID);
+        return items;
+    }
+
+    bool push(T* item, const ThreadContext& context) { return push(item, context.id(numOfThreads)); }
+
+    T* pop(const ThreadContext& context) { return pop(context.id(numOfThreads)); }
+
+    bool push(T* item) { return push(item, ThreadContext::current()); }
+
+    T* pop() { return pop(ThreadContext::current()); }
+
+    template<typename Iterator>
+    bool pushBatch(Iterator first, Iterator last, const ThreadContext& context) { return pushBatch(first, last, context.id(numOfThreads)); }
+
+    int popBatch(int n, T** out, const ThreadContext& context) { return popBatch(n, out, context.id(numOfThreads)); }
+
+    std::vector<T*> popAll(const ThreadContext& context) { return popAll(context.id(numOfThreads)); }
+
+    template<typename Iterator>
+    bool pushBatch(Iterator first, Iterator last) { return pushBatch(first, last, ThreadContext::current()); }
+
+    int popBatch(int n, T** out) { return popBatch(n, out, ThreadContext::current()); }
+
+    std::vector<T*> popAll() { return popAll(ThreadContext::current()); }
+
+    uint64_t getRetiredCountStack(int threadID)
+    {
+        return reclaimer.retiredCount(threadID);
+    }
+};
+
+#endif
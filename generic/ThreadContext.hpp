@@ -0,0 +1,101 @@
+#ifndef THREAD_CONTEXT_HPP
+#define THREAD_CONTEXT_HPP
+
+#include <atomic>
+#include <stdexcept>
+
+#define THREAD_CONTEXT_MAX_THREADS 128
+
+// Hands out the dense thread ids that the reclaimers index their per-thread
+// slots and retire lists with. Ids are claimed lowest-first and given back
+// when the thread exits, so threads from a pool, or threads started and
+// stopped over time, keep reusing the ids below the number of threads alive.
+class ThreadRegistry {
+private:
+    std::atomic<bool> used[THREAD_CONTEXT_MAX_THREADS];
+
+    ThreadRegistry()
+    {
+        for (int i = 0; i < THREAD_CONTEXT_MAX_THREADS; i++) {
+            used[i].store(false, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    static ThreadRegistry& global()
+    {
+        static ThreadRegistry registry;
+        return registry;
+    }
+
+    int acquire()
+    {
+        for (int i = 0; i < THREAD_CONTEXT_MAX_THREADS; i++) {
+            bool expected = false;
+            if (!used[i].load(std::memory_order_relaxed) && used[i].compare_exchange_strong(expected, true)) {
+                return i;
+            }
+        }
+        throw std::runtime_error("ThreadRegistry: more than THREAD_CONTEXT_MAX_THREADS threads alive");
+    }
+
+    void release(int id)
+    {
+        used[id].store(false, std::memory_order_release);
+    }
+};
+
+// A thread's registration, taken on first use and released when the thread
+// exits. Containers accept it in place of a raw thread id; callers in a hot
+// loop fetch it once with current() and pass it along, everyone else uses the
+// overloads without a thread argument.
+//
+// Only the id is cached. The reclaimers still index their per-thread slot
+// rows and retire lists with it on every call, and the context overloads add
+// one compare over the raw-id calls: a container's thread count must cover
+// the registered threads alive at once, as ids are handed out lowest-first
+// across the whole process, and an id past it throws std::out_of_range
+// rather than index past the reclaimer's per-thread arrays. Callers that
+// manage dense ids themselves can keep using the raw-id calls.
+class ThreadContext {
+private:
+    int tid;
+
+    ThreadContext() : tid{ThreadRegistry::global().acquire()} { }
+
+    ThreadContext(const ThreadContext&) = delete;
+    ThreadContext& operator=(const ThreadContext&) = delete;
+
+public:
+    ~ThreadContext()
+    {
+        ThreadRegistry::global().release(tid);
+    }
+
+    static ThreadContext& current()
+    {
+        static thread_local ThreadContext context;
+        return context;
+    }
+
+    int id() const { return tid; }
+
+    // The id, for a container sized for numThreads threads
+    int id(int numThreads) const
+    {
+        if (tid >= numThreads) {
+            outOfRange();
+        }
+        return tid;
+    }
+
+private:
+    // noreturn, so the compiler treats the throw as the cold path and the
+    // check in id(numThreads) stays a compare and branch
+    [[noreturn]] static void outOfRange()
+    {
+        throw std::out_of_range("ThreadContext: id not below the container's thread count");
+    }
+};
+
+#endif
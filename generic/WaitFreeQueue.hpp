@@ -0,0 +1,477 @@
+#ifndef GENERIC_WAIT_FREE_QUEUE_HPP
+#define GENERIC_WAIT_FREE_QUEUE_HPP
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include "Reclaimers.hpp"
+#include "Allocators.hpp"
+#include "ThreadContext.hpp"
+#include "ParkingLot.hpp"
+
+#define WF_QUEUE_MAX_THREADS 64
+#define WF_FAST_PATH_TRIES 16
+#define WF_HELPING_DELAY 64
+#define WF_UNCLAIMED (-1)
+#define WF_FAST_CLAIM (-2)
+
+// Wait-free queue of Kogan and Petrank, in its fast-path/slow-path form.
+// Every operation first tries a bounded number of Michael-Scott steps. Once
+// those fail it publishes an operation record with a phase taken from a
+// global counter, and every thread that starts a slow operation helps all
+// pending records with an older phase, so each operation finishes within a
+// bounded number of steps whatever the others do. Fast operations also check
+// one other thread every WF_HELPING_DELAY operations and help it if its
+// record has not moved since the last check.
+//
+// Nodes and records are reclaimed through two instances of the policy. A
+// record is retired by whoever replaces it in state. A node is retired by
+// the dequeuer that claimed it through deqTid, once head has moved past it.
+// The item a slow dequeue takes is copied into its final record by whoever
+// finishes it, so the dequeuer never reads a node another thread may retire.
+//
+// Node slots: 0 head or tail, 1 its next, 2 the node of an enqueue record.
+// Record slots: 0 the record being looked at, 1 the record about to be
+// replaced, 2 the pending check.
+template<typename T, template<typename> class Reclaimer, template<typename> class Allocator = DEFAULT_NODE_ALLOCATOR>
+class WaitFreeQueue
+{
+
+private:
+    struct Node : NodeHeaderOf<Reclaimer>::type {
+        T* item;
+        std::atomic<Node*> next;
+        const int enqTid;
+        std::atomic<int> deqTid;
+
+        Node(T* item, int enqTid) : item{item}, next{nullptr}, enqTid{enqTid}, deqTid{WF_UNCLAIMED} { }
+
+        bool casNext(Node *cmp, Node *val) {
+            return next.compare_exchange_strong(cmp, val);
+        }
+
+        static void* operator new(size_t) { return Allocator<Node>::allocate(); }
+
+        static void operator delete(void* ptr) { Allocator<Node>::deallocate(ptr); }
+    };
+
+    // Never modified once published: a change is a new record swapped in.
+    // node is atomic only so helpers can hand it to protect like any other
+    // shared link.
+    struct OpDesc : NodeHeaderOf<Reclaimer>::type {
+        const long long phase;
+        const bool pending;
+        const bool enqueue;
+        const std::atomic<Node*> node;
+        // Item taken by a finished dequeue
+        T* const item;
+
+        OpDesc(long long phase, bool pending, bool enqueue, Node* node, T* item)
+            : phase{phase}, pending{pending}, enqueue{enqueue}, node{node}, item{item} { }
+
+        static void* operator new(size_t) { return Allocator<OpDesc>::allocate(); }
+
+        static void operator delete(void* ptr) { Allocator<OpDesc>::deallocate(ptr); }
+    };
+
+    // Touched only by its own thread
+    struct alignas(64) HelpRecord {
+        int tid;
+        long long phase;
+        int countdown;
+    };
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    const int numOfThreads;
+    Reclaimer<Node> reclaimer{numOfThreads};
+    Reclaimer<OpDesc> descReclaimer{numOfThreads};
+    ParkingLot parking;
+    std::atomic<long long> phaseCounter{0};
+    std::atomic<OpDesc*> state[WF_QUEUE_MAX_THREADS];
+    HelpRecord helpRecords[WF_QUEUE_MAX_THREADS];
+
+    // Runs before the reclaimers are built, as the state and help arrays are
+    // sized WF_QUEUE_MAX_THREADS; the reclaimers then refuse a count their
+    // own domains have no rows for
+    static int checkThreads(int numOfThreads)
+    {
+        if(numOfThreads > WF_QUEUE_MAX_THREADS)
+        {
+            throw std::runtime_error("WaitFreeQueue: more than WF_QUEUE_MAX_THREADS threads");
+        }
+        return numOfThreads;
+    }
+
+    // Swaps newDesc in for curDesc, or frees it if state[tid] has moved on
+    void replaceDesc(int tid, OpDesc* curDesc, OpDesc* newDesc, int threadID)
+    {
+        if(state[tid].compare_exchange_strong(curDesc, newDesc))
+        {
+            descReclaimer.retire(curDesc, threadID);
+        }
+        else
+        {
+            delete newDesc;
+        }
+    }
+
+    bool isStillPending(int tid, long long phase, int threadID)
+    {
+        OpDesc* desc = descReclaimer.protect(2, state[tid], threadID);
+        return desc->pending && desc->phase <= phase;
+    }
+
+    void help(long long phase, int threadID)
+    {
+        for(int tid = 0; tid < numOfThreads; tid++)
+        {
+            OpDesc* desc = descReclaimer.protect(0, state[tid], threadID);
+            if(desc->pending && desc->phase <= phase)
+            {
+                if(desc->enqueue)
+                {
+                    helpEnq(tid, phase, threadID);
+                }
+                else
+                {
+                    helpDeq(tid, phase, threadID);
+                }
+            }
+        }
+    }
+
+    // Checks one thread every WF_HELPING_DELAY operations and helps it if it
+    // is still on the record it had at the previous check
+    void helpIfNeeded(int threadID)
+    {
+        HelpRecord& record = helpRecords[threadID];
+        if(--record.countdown > 0)
+        {
+            return;
+        }
+        OpDesc* desc = descReclaimer.protect(0, state[record.tid], threadID);
+        if(desc->pending && desc->phase == record.phase)
+        {
+            if(desc->enqueue)
+            {
+                helpEnq(record.tid, desc->phase, threadID);
+            }
+            else
+            {
+                helpDeq(record.tid, desc->phase, threadID);
+            }
+        }
+        record.tid = (record.tid + 1) % numOfThreads;
+        record.phase = descReclaimer.protect(0, state[record.tid], threadID)->phase;
+        record.countdown = WF_HELPING_DELAY;
+    }
+
+    void helpEnq(int tid, long long phase, int threadID)
+    {
+        while(isStillPending(tid, phase, threadID))
+        {
+            Node* last = reclaimer.protect(0, tail, threadID);
+            Node* next = reclaimer.protect(1, last->next, threadID);
+            if(last != tail.load())
+            {
+                continue;
+            }
+            if(next != nullptr)
+            {
+                helpFinishEnq(threadID);
+                continue;
+            }
+            OpDesc* desc = descReclaimer.protect(1, state[tid], threadID);
+            if(!desc->pending || desc->phase > phase)
+            {
+                return;
+            }
+            // While the record is still in place its node has not been
+            // linked at or before last, so it cannot be linked twice. The
+            // state check below also validates the hazard on it.
+            Node* node = reclaimer.protect(2, desc->node, threadID);
+            if(state[tid].load() != desc)
+            {
+                continue;
+            }
+            if(last->casNext(nullptr, node))
+            {
+                helpFinishEnq(threadID);
+                return;
+            }
+        }
+    }
+
+    // Marks the enqueue that linked the node after tail as done, then swings
+    // tail to it
+    void helpFinishEnq(int threadID)
+    {
+        Node* last = reclaimer.protect(0, tail, threadID);
+        Node* next = reclaimer.protect(1, last->next, threadID);
+        if(next == nullptr || last != tail.load())
+        {
+            return;
+        }
+        int tid = next->enqTid;
+        OpDesc* curDesc = descReclaimer.protect(1, state[tid], threadID);
+        if(last == tail.load() && curDesc->pending && curDesc->node.load() == next)
+        {
+            OpDesc* newDesc = descReclaimer.alloc(new OpDesc(curDesc->phase, false, true, next, nullptr), threadID);
+            replaceDesc(tid, curDesc, newDesc, threadID);
+        }
+        tail.compare_exchange_strong(last, next);
+    }
+
+    void helpDeq(int tid, long long phase, int threadID)
+    {
+        while(isStillPending(tid, phase, threadID))
+        {
+            Node* first = reclaimer.protect(0, head, threadID);
+            Node* last = tail.load();
+            Node* next = reclaimer.protect(1, first->next, threadID);
+            if(first != head.load())
+            {
+                continue;
+            }
+            if(first == last)
+            {
+                if(next != nullptr)
+                {
+                    helpFinishEnq(threadID);
+                    continue;
+                }
+                // Empty: finish the dequeue with no node
+                OpDesc* curDesc = descReclaimer.protect(1, state[tid], threadID);
+                if(last == tail.load() && curDesc->pending && curDesc->phase <= phase)
+                {
+                    OpDesc* newDesc = descReclaimer.alloc(new OpDesc(curDesc->phase, false, false, nullptr, nullptr), threadID);
+                    replaceDesc(tid, curDesc, newDesc, threadID);
+                }
+                continue;
+            }
+            OpDesc* curDesc = descReclaimer.protect(1, state[tid], threadID);
+            if(!curDesc->pending || curDesc->phase > phase)
+            {
+                return;
+            }
+            if(first == head.load() && curDesc->node.load() != first)
+            {
+                OpDesc* newDesc = descReclaimer.alloc(new OpDesc(curDesc->phase, true, false, first, nullptr), threadID);
+                if(!state[tid].compare_exchange_strong(curDesc, newDesc))
+                {
+                    delete newDesc;
+                    continue;
+                }
+                descReclaimer.retire(curDesc, threadID);
+            }
+            int unclaimed = WF_UNCLAIMED;
+            first->deqTid.compare_exchange_strong(unclaimed, tid);
+            helpFinishDeq(threadID);
+        }
+    }
+
+    // Marks the dequeue that claimed head as done, with the item of the node
+    // after it, then swings head to that node
+    void helpFinishDeq(int threadID)
+    {
+        Node* first = reclaimer.protect(0, head, threadID);
+        Node* next = reclaimer.protect(1, first->next, threadID);
+        if(first != head.load())
+        {
+            return;
+        }
+        int tid = first->deqTid.load();
+        if(tid == WF_UNCLAIMED || next == nullptr)
+        {
+            return;
+        }
+        if(tid != WF_FAST_CLAIM)
+        {
+            OpDesc* curDesc = descReclaimer.protect(1, state[tid], threadID);
+            if(first == head.load() && curDesc->pending)
+            {
+                OpDesc* newDesc = descReclaimer.alloc(new OpDesc(curDesc->phase, false, false, first, next->item), threadID);
+                replaceDesc(tid, curDesc, newDesc, threadID);
+            }
+        }
+        head.compare_exchange_strong(first, next);
+    }
+
+    bool enqueueFast(Node* node, int threadID)
+    {
+        Node* last = reclaimer.protect(0, tail, threadID);
+        Node* next = reclaimer.protect(1, last->next, threadID);
+        if(last != tail.load())
+        {
+            return false;
+        }
+        if(next != nullptr)
+        {
+            helpFinishEnq(threadID);
+            return false;
+        }
+        if(last->casNext(nullptr, node))
+        {
+            tail.compare_exchange_strong(last, node);
+            return true;
+        }
+        return false;
+    }
+
+    void enqueueSlow(Node* node, int threadID)
+    {
+        long long phase = phaseCounter.fetch_add(1) + 1;
+        OpDesc* desc = descReclaimer.alloc(new OpDesc(phase, true, true, node, nullptr), threadID);
+        descReclaimer.retire(state[threadID].exchange(desc), threadID);
+        help(phase, threadID);
+        helpFinishEnq(threadID);
+    }
+
+    // Claims head with WF_FAST_CLAIM instead of a thread id, so finishing
+    // the dequeue never touches state. Returns false to retry.
+    bool dequeueFast(T*& item, int threadID)
+    {
+        Node* first = reclaimer.protect(0, head, threadID);
+        Node* last = tail.load();
+        Node* next = reclaimer.protect(1, first->next, threadID);
+        if(first != head.load())
+        {
+            return false;
+        }
+        if(first == last)
+        {
+            if(next == nullptr)
+            {
+                item = nullptr;
+                return true;
+            }
+            helpFinishEnq(threadID);
+            return false;
+        }
+        int unclaimed = WF_UNCLAIMED;
+        if(next == nullptr || !first->deqTid.compare_exchange_strong(unclaimed, WF_FAST_CLAIM))
+        {
+            helpFinishDeq(threadID);
+            return false;
+        }
+        item = next->item;
+        Node* expected = first;
+        head.compare_exchange_strong(expected, next);
+        reclaimer.retire(first, threadID);
+        return true;
+    }
+
+    T* dequeueSlow(int threadID)
+    {
+        long long phase = phaseCounter.fetch_add(1) + 1;
+        OpDesc* desc = descReclaimer.alloc(new OpDesc(phase, true, false, nullptr, nullptr), threadID);
+        descReclaimer.retire(state[threadID].exchange(desc), threadID);
+        help(phase, threadID);
+        // Head may still be on the claimed node: move it on before retiring
+        helpFinishDeq(threadID);
+        OpDesc* done = descReclaimer.protect(0, state[threadID], threadID);
+        Node* node = done->node.load();
+        if(node == nullptr)
+        {
+            return nullptr;
+        }
+        reclaimer.retire(node, threadID);
+        return done->item;
+    }
+
+public:
+
+    WaitFreeQueue(int numOfThreads) : numOfThreads{checkThreads(numOfThreads)} {
+        Node* sentinel = reclaimer.alloc(new Node(nullptr, 0), 0);
+        head.store(sentinel, std::memory_order_relaxed);
+        tail.store(sentinel, std::memory_order_relaxed);
+        for(int tid = 0; tid < WF_QUEUE_MAX_THREADS; tid++)
+        {
+            state[tid].store(descReclaimer.alloc(new OpDesc(-1, false, true, nullptr, nullptr), 0), std::memory_order_relaxed);
+            helpRecords[tid].tid = (tid + 1) % numOfThreads;
+            helpRecords[tid].phase = -1;
+            helpRecords[tid].countdown = WF_HELPING_DELAY;
+        }
+    }
+
+    ~WaitFreeQueue(){
+        while(dequeue(0) != nullptr);
+        delete head.load();
+        for(int tid = 0; tid < WF_QUEUE_MAX_THREADS; tid++)
+        {
+            delete state[tid].load();
+        }
+    }
+
+    bool enqueue(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = reclaimer.alloc(new Node(item, threadID), threadID);
+        reclaimer.begin(threadID);
+        descReclaimer.begin(threadID);
+        helpIfNeeded(threadID);
+        bool done = false;
+        for(int i = 0; i < WF_FAST_PATH_TRIES && !done; i++)
+        {
+            done = enqueueFast(node, threadID);
+        }
+        if(!done)
+        {
+            enqueueSlow(node, threadID);
+        }
+        descReclaimer.end(threadID);
+        reclaimer.end(threadID);
+        parking.notify();
+        return true;
+    }
+
+    T* dequeue(int threadID)
+    {
+        reclaimer.begin(threadID);
+        descReclaimer.begin(threadID);
+        helpIfNeeded(threadID);
+        T* item = nullptr;
+        bool done = false;
+        for(int i = 0; i < WF_FAST_PATH_TRIES && !done; i++)
+        {
+            done = dequeueFast(item, threadID);
+        }
+        if(!done)
+        {
+            item = dequeueSlow(threadID);
+        }
+        descReclaimer.end(threadID);
+        reclaimer.end(threadID);
+        return item;
+    }
+
+    // Like dequeue, but parks on an empty queue until an item arrives or
+    // timeout has passed, when it returns nullptr
+    T* dequeueWait(int threadID, std::chrono::nanoseconds timeout)
+    {
+        return parking.wait([&] { return dequeue(threadID); }, timeout);
+    }
+
+    bool enqueue(T* item, const ThreadContext& context) { return enqueue(item, context.id(numOfThreads)); }
+
+    T* dequeue(const ThreadContext& context) { return dequeue(context.id(numOfThreads)); }
+
+    T* dequeueWait(const ThreadContext& context, std::chrono::nanoseconds timeout) { return dequeueWait(context.id(numOfThreads), timeout); }
+
+    bool enqueue(T* item) { return enqueue(item, ThreadContext::current()); }
+
+    T* dequeue() { return dequeue(ThreadContext::current()); }
+
+    T* dequeueWait(std::chrono::nanoseconds timeout) { return dequeueWait(ThreadContext::current(), timeout); }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return reclaimer.retiredCount(threadID) + descReclaimer.retiredCount(threadID);
+    }
+};
+
+#endif
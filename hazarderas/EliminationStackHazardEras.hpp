@@ -0,0 +1,9 @@
+#ifndef ELIMINATION_STACK_HAZARD_ERAS_HPP
+#define ELIMINATION_STACK_HAZARD_ERAS_HPP
+
+#include "../generic/EliminationStack.hpp"
+
+template<typename T>
+using EliminationStack_HazardEras = EliminationStack<T, HazardErasReclaimer>;
+
+#endif
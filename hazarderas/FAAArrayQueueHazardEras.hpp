@@ -0,0 +1,9 @@
+#ifndef FAA_ARRAY_QUEUE_HAZARD_ERAS_HPP
+#define FAA_ARRAY_QUEUE_HAZARD_ERAS_HPP
+
+#include "../generic/FAAArrayQueue.hpp"
+
+template<typename T>
+using FAAArrayQueue_HazardEras = FAAArrayQueue<T, HazardErasReclaimer>;
+
+#endif
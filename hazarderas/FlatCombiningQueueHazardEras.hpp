@@ -0,0 +1,9 @@
+#ifndef FLAT_COMBINING_QUEUE_HAZARD_ERAS_HPP
+#define FLAT_COMBINING_QUEUE_HAZARD_ERAS_HPP
+
+#include "../generic/FlatCombiningQueue.hpp"
+
+template<typename T>
+using FlatCombiningQueue_HazardEras = FlatCombiningQueue<T, HazardErasReclaimer>;
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef WAIT_FREE_QUEUE_HAZARD_ERAS_HPP
+#define WAIT_FREE_QUEUE_HAZARD_ERAS_HPP
+
+#include "../generic/WaitFreeQueue.hpp"
+
+template<typename T>
+using WaitFreeQueue_HazardEras = WaitFreeQueue<T, HazardErasReclaimer>;
+
+#endif
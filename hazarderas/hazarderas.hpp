@@ -79,12 +79,12 @@ public:
         hazardErasList[threadID][eraIndex].store(era, std::memory_order_release);
     }
 
-    bool canRemoveNode(T* item, const int threadID) {
+    bool canRemoveNode(T* item) {
         for (int i = 0; i < HE_MAX_NUMBER_OF_THREADS; i++) 
         {
             for (int j = 0; j < MAX_NUMBER_OF_HAZARD_ERAS_PER_THREAD; j++) 
             {
-                uint64_t era = hazardErasList[threadID][j].load(std::memory_order_acquire);
+                uint64_t era = hazardErasList[i][j].load(std::memory_order_acquire);
                 if (era == emptyEra || era < item->newEra || era > item->delEra) 
                 {
                     continue;
@@ -104,17 +104,45 @@ public:
         {
             globalEraClock.fetch_add(1);
         }
-        for (int i = 0; i < retiredPtrList[threadID].size();i++) 
+        emptyRetireList(threadID);
+    }
+
+    // Same as retireNode for each node, with one era advance and one scan
+    void retireNodes(const std::vector<T*>& items, int threadID) {
+        if (items.empty())
+        {
+            return;
+        }
+        auto currEra = globalEraClock.load();
+        for (auto item : items)
+        {
+            item->delEra = currEra;
+            retiredPtrList[threadID].push_back(item);
+        }
+        retiredNodesCount[threadID] += items.size();
+        if (globalEraClock == currEra) 
+        {
+            globalEraClock.fetch_add(1);
+        }
+        emptyRetireList(threadID);
+    }
+
+    // Compacts the survivors in place, so a scan is linear in the list
+    void emptyRetireList(int threadID) {
+        std::vector<T*>& retired = retiredPtrList[threadID];
+        size_t kept = 0;
+        for (size_t i = 0; i < retired.size(); i++) 
         {
-            auto stptr = retiredPtrList[threadID][i];
-            if (canRemoveNode(stptr, threadID)) 
+            auto stptr = retired[i];
+            if (canRemoveNode(stptr)) 
             {
-                retiredPtrList[threadID].erase(retiredPtrList[threadID].begin() + i);
                 delete stptr;
                 retiredNodesCount[threadID] -= 1;
                 continue;
             }
+            retired[kept++] = stptr;
         }
+        retired.resize(kept);
     }
 
     uint64_t getRetiredNodeCount(int threadID){
@@ -10,19 +10,48 @@
 // Hazard Pointers with different data structures
 #include "LinkedListHazardPointer.hpp"
 #include "QueueHazardPointer.hpp" 
+#include "QueueSharedHazardPointer.hpp"
+#include "FAAArrayQueueHazardPointer.hpp"
+#include "MultiQueueHazardPointer.hpp"
+#include "FlatCombiningQueueHazardPointer.hpp"
+#include "WaitFreeQueueHazardPointer.hpp"
 #include "StackHazardPointer.hpp"
+#include "StackSharedHazardPointer.hpp"
+#include "EliminationStackHazardPointer.hpp"
+
+// No-reclamation baseline for the HP++ linked list; the generic containers
+// are compared against themselves instantiated with LeakReclaimer
+#include "../baseline/LinkedListBaseline.hpp"
 
 using namespace std;
 using namespace chrono;
 
+#define QUEUE_LATENCY_SAMPLE_PERIOD 64
+#define QUEUE_LATENCY_MAX_SAMPLES 65536
+
 class Benchmarks {
 
 private:
     int numThreads;
+    long long baselineOps;
 
 public:
     Benchmarks(int numThreads) {
         this->numThreads = numThreads;
+        this->baselineOps = 0;
+    }
+
+    void setBaselineOps(long long ops) {
+        baselineOps = ops;
+    }
+
+    // Best-run throughput, the statistic printed as Ops/sec, as a percentage of
+    // the no-reclamation run once one is set
+    string baselineReport(long long ops) {
+        if (baselineOps <= 0) {
+            return "";
+        }
+        return ", " + to_string((long)(100. * ops / baselineOps)) + "% of no-reclamation";
     }
 
     template<typename Q>
@@ -49,13 +78,23 @@ public:
             }
         }
 
+        // Latencies of every QUEUE_LATENCY_SAMPLE_PERIOD-th iteration, in ns.
+        // Each thread writes a ring allocated up front, so sampling never
+        // allocates inside the measured loop, and keeps its latest
+        // QUEUE_LATENCY_MAX_SAMPLES samples.
+        vector<vector<long long>> latencies(numThreads, vector<long long>(QUEUE_LATENCY_MAX_SAMPLES));
+        vector<long long> samplesTaken(numThreads, 0);
+
         // Can either be a Reader or a Writer
-        auto rw_lambda = [this,&update_ratio,&quit,&startFlag,&queue,&total_elements, &elements](long long *ops, const int tid) {
+        auto rw_lambda = [this,&update_ratio,&quit,&startFlag,&queue,&total_elements, &elements](long long *ops, vector<long long> *latencies, long long *samples, const int tid) {
             long long numOps = 0;
+            long long iterations = 0;
             uint64_t seed = tid;
             srand(time(NULL));
             while (!startFlag.load()) { } // spin
             while (!quit.load()) {
+                bool sampled = (iterations++ % QUEUE_LATENCY_SAMPLE_PERIOD) == 0;
+                auto opStart = sampled ? steady_clock::now() : steady_clock::time_point();
                 // seed = randomLong(seed);
                 seed = rand()*total_elements + 1;
                 auto ix = (unsigned int)(seed%total_elements);
@@ -70,6 +109,9 @@ public:
                 } else {
                     queue->dequeue(tid);
                 }
+                if (sampled) {
+                    (*latencies)[(*samples)++ % QUEUE_LATENCY_MAX_SAMPLES] = duration_cast<nanoseconds>(steady_clock::now() - opStart).count();
+                }
                 numOps+=1;
             }
             *ops = numOps;
@@ -86,7 +128,7 @@ public:
             thread rwThreads[numThreads];
             for (int tid = 0; tid < numThreads; tid++) 
             {
-                rwThreads[tid] = thread(rw_lambda, &ops[tid][irun], tid);
+                rwThreads[tid] = thread(rw_lambda, &ops[tid][irun], &latencies[tid], &samplesTaken[tid], tid);
             }
 
             startFlag.store(true);
@@ -134,13 +176,27 @@ public:
         auto medianops = agg[total_runs/2];
         auto delta = (long)(100.*(maxops-minops) / ((double)medianops));
 
+        // Tail latency of a dequeue, plus its enqueue when it got an item,
+        // over the samples of all runs and threads
+        vector<long long> samples;
+        for (int tid = 0; tid < numThreads; tid++) {
+            long long kept = min(samplesTaken[tid], (long long)QUEUE_LATENCY_MAX_SAMPLES);
+            samples.insert(samples.end(), latencies[tid].begin(), latencies[tid].begin() + kept);
+        }
+        long long p999 = 0;
+        if (!samples.empty()) {
+            auto nth = samples.begin() + (samples.size() * 999) / 1000;
+            nth_element(samples.begin(), nth, samples.end());
+            p999 = *nth;
+        }
+
         // Printed value is the median of the number of ops per second that all threads were able to accomplish (on average)
         // std::cout << "Ops/sec = " << medianops << "   delta = " << delta << "%   min = " << minops << "   max = " << maxops << "\n";
         // std::cout << "Number of Unreclaimed Nodes = " << medianretiredagg << "\n";
 
-        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<"\n\n";
+        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<", p99.9 latency = "<<p999<<" ns"<<baselineReport(maxops)<<"\n\n";
 
-        return medianops;
+        return maxops;
     }
 
     template<typename S>
@@ -255,9 +311,9 @@ public:
         // std::cout << "Ops/sec = " << medianops << "   delta = " << delta << "%   min = " << minops << "   max = " << maxops << "\n";
         // std::cout << "Number of Unreclaimed Nodes = " << medianretiredagg << "\n";
 
-        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<"\n\n";
+        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<baselineReport(maxops)<<"\n\n";
 
-        return medianops;
+        return maxops;
     }
 
     template<typename L>
@@ -373,9 +429,9 @@ public:
         // std::cout << "Ops/sec = " << medianops << "   delta = " << delta << "%   min = " << minops << "   max = " << maxops << "\n";
         // std::cout << "Number of Unreclaimed Nodes = " << medianretiredagg << "\n";
 
-        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<"\n\n";
+        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<baselineReport(maxops)<<"\n\n";
 
-        return medianops;
+        return maxops;
     }
 };
 
@@ -420,16 +476,74 @@ int main(int argc, char* argv[])
             
             if(strcmp(ds_type, "linkedlist") == 0)
             {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkLinkedList<LinkedList_Leak<int>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
                 bench.benchmarkLinkedList<LinkedList_HazardPointer<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
             }
             else if(strcmp(ds_type, "queue") == 0)
             {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<Queue<int, LeakReclaimer, QUEUE_NODE_ALLOCATOR>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
                 bench.benchmarkQueues<Queue_HazardPointer<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
             }
+            else if(strcmp(ds_type, "sharedqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<Queue<int, LeakReclaimer, QUEUE_NODE_ALLOCATOR>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<Queue_SharedHazardPointer<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
+            else if(strcmp(ds_type, "faaqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<FAAArrayQueue<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<FAAArrayQueue_HazardPointer<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
+            else if(strcmp(ds_type, "multiqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<MultiQueue<int, LeakReclaimer, QUEUE_NODE_ALLOCATOR>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<MultiQueue_HazardPointer<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
+            else if(strcmp(ds_type, "fcqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<FlatCombiningQueue<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<FlatCombiningQueue_HazardPointer<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
+            else if(strcmp(ds_type, "wfqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<WaitFreeQueue<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<WaitFreeQueue_HazardPointer<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
             else if(strcmp(ds_type, "stack") == 0)
             {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkStacks<Stack<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
                 bench.benchmarkStacks<Stack_HazardPointer<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
             }
+            else if(strcmp(ds_type, "sharedstack") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkStacks<Stack<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkStacks<Stack_SharedHazardPointer<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
+            else if(strcmp(ds_type, "eliminationstack") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkStacks<EliminationStack<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkStacks<EliminationStack_HazardPointer<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
             else
             {
                 std::cout<<"ERROR: Enter appropriate data structure\n";
@@ -0,0 +1,9 @@
+#ifndef ELIMINATION_STACK_HAZARD_POINTER_HPP
+#define ELIMINATION_STACK_HAZARD_POINTER_HPP
+
+#include "../generic/EliminationStack.hpp"
+
+template<typename T>
+using EliminationStack_HazardPointer = EliminationStack<T, HazardPointerReclaimer>;
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef FAA_ARRAY_QUEUE_HAZARD_POINTER_HPP
+#define FAA_ARRAY_QUEUE_HAZARD_POINTER_HPP
+
+#include "../generic/FAAArrayQueue.hpp"
+
+template<typename T>
+using FAAArrayQueue_HazardPointer = FAAArrayQueue<T, HazardPointerReclaimer>;
+
+#endif
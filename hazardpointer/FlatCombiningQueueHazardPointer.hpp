@@ -0,0 +1,9 @@
+#ifndef FLAT_COMBINING_QUEUE_HAZARD_POINTER_HPP
+#define FLAT_COMBINING_QUEUE_HAZARD_POINTER_HPP
+
+#include "../generic/FlatCombiningQueue.hpp"
+
+template<typename T>
+using FlatCombiningQueue_HazardPointer = FlatCombiningQueue<T, HazardPointerReclaimer>;
+
+#endif
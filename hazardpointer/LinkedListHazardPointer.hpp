@@ -12,11 +12,13 @@ private:
     struct Node {
         T* item;
         std::atomic<Node*> next;
+        std::atomic<bool> invalidated;
 
         Node(T* item) 
         {
             this->item = item;
             this->next.store(nullptr);
+            this->invalidated.store(false, std::memory_order_relaxed);
         }
     };
 
@@ -39,9 +41,8 @@ private:
 
 public:
 
-    LinkedList_HazardPointer(int numThreads) 
+    LinkedList_HazardPointer(int numThreads) : numofThreads{numThreads}
     {
-        numofThreads = numThreads;
         Node* sentinel = new Node(nullptr);
         head.store(sentinel);
         tail.store(sentinel);
@@ -86,14 +87,8 @@ public:
             if (!curr->next.compare_exchange_strong(temp, getMarked(next))) {
                 continue;
             }
-            temp = getUnmarked(curr);
-            if (pred->compare_exchange_strong(temp, getUnmarked(next))) 
-            {
-                hpList.clear(threadID);
-                hpList.retireNode(getUnmarked(curr), threadID);
-            } else {
-                hpList.clear(threadID);
-            }
+            hpList.tryUnlink(*pred, getUnmarked(curr), getUnmarked(next), threadID);
+            hpList.clear(threadID);
             return true;
         }
     }
@@ -112,57 +107,77 @@ public:
 
 private:
 
+    // Harris-style traversal on top of the HP++ extension: hops are
+    // validated by checking that the source node has not been invalidated,
+    // not that it is still linked from pred, so the traversal walks through
+    // runs of marked nodes and cuts each run out with a single CAS instead of
+    // restarting from head. Slots: 0 next, 1 curr, 2 pred, 3 first marked node
+    // of the current run, HPPP_FRONTIER_INDEX is used by tryUnlink.
     bool find (T* item, std::atomic<Node*> **par_pred, Node **par_curr, Node **par_next, const int threadID)
     {
         std::atomic<Node*> *pred;
-        Node *curr, *next;
+        Node *curr, *next, *first;
 
      try_again:
         pred = &head;
-        curr = pred->load();
-        hpList.storeHazardPtr(1, curr, threadID);
+        first = nullptr;
+        next = nullptr;
+        curr = head.load();
+        hpList.tryProtect(1, curr, head, nullptr, threadID);
         while (true) {
-            if (getUnmarked(curr) == nullptr) 
+            if (curr == nullptr) 
             {
                 break;
             }
             next = curr->next.load();
-            hpList.storeHazardPtr(0, getUnmarked(next), threadID);
-            if (getUnmarked(curr)->next.load() != next) 
+            if (!hpList.tryProtect(0, next, curr->next, curr, threadID)) 
             {
                 goto try_again;
             }
-            if (getUnmarked(next) == tail.load()) 
+            if (isMarked(next)) 
             {
-                break;
-            }
-            if (pred->load() != getUnmarked(curr)) 
-            {
-                goto try_again;
-            }
-            if (getUnmarked(next) == next)
-            { 
-                if (getUnmarked(curr)->item != nullptr && !(*getUnmarked(curr)->item < *item)) 
+                if (first == nullptr) 
                 {
-                    *par_curr = curr;
-                    *par_pred = pred;
-                    *par_next = next;
-                    return (*getUnmarked(curr)->item == *item);
+                    first = curr;
+                    hpList.storeHazardPtr(3, first, threadID);
+                }
+                if (getUnmarked(next) == tail.load()) 
+                {
+                    if (!hpList.tryUnlink(*pred, first, tail.load(), threadID)) 
+                    {
+                        goto try_again;
+                    }
+                    curr = tail.load();
+                    next = curr->next.load();
+                    break;
                 }
-                pred = &getUnmarked(curr)->next;
-                hpList.storeHazardPtr(2, getUnmarked(curr), threadID);
             } 
             else 
             {
-                Node *temp = getUnmarked(curr);
-                if (!pred->compare_exchange_strong(temp, getUnmarked(next))) 
+                if (first != nullptr) 
+                {
+                    if (!hpList.tryUnlink(*pred, first, curr, threadID)) 
+                    {
+                        goto try_again;
+                    }
+                    first = nullptr;
+                }
+                if (next == tail.load()) 
                 {
-                    goto try_again;
+                    break;
+                }
+                if (curr->item != nullptr && !(*curr->item < *item)) 
+                {
+                    *par_curr = curr;
+                    *par_pred = pred;
+                    *par_next = next;
+                    return (*curr->item == *item);
                 }
-                hpList.retireNode(getUnmarked(curr), threadID);
+                pred = &curr->next;
+                hpList.storeHazardPtr(2, curr, threadID);
             }
-            curr = next;
-            hpList.storeHazardPtr(1, getUnmarked(next), threadID);
+            curr = getUnmarked(next);
+            hpList.storeHazardPtr(1, curr, threadID);
         }
         *par_curr = curr;
         *par_pred = pred;
@@ -0,0 +1,10 @@
+#ifndef MULTI_QUEUE_HAZARD_POINTER_HPP
+#define MULTI_QUEUE_HAZARD_POINTER_HPP
+
+#include "../generic/MultiQueue.hpp"
+
+// Lanes take their nodes from QUEUE_NODE_ALLOCATOR, like the Michael-Scott queue
+template<typename T>
+using MultiQueue_HazardPointer = MultiQueue<T, HazardPointerReclaimer, QUEUE_NODE_ALLOCATOR>;
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef QUEUE_SHARED_HAZARD_POINTER_HPP
+#define QUEUE_SHARED_HAZARD_POINTER_HPP
+
+#include "../generic/Queue.hpp"
+
+// Hazard pointers from the process-wide SharedHazardDomain; nodes come from
+// QUEUE_NODE_ALLOCATOR, RecyclingAllocator by default
+template<typename T>
+using Queue_SharedHazardPointer = Queue<T, SharedHazardPointerReclaimer, QUEUE_NODE_ALLOCATOR>;
+
+#endif
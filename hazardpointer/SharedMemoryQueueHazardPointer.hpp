@@ -0,0 +1,391 @@
+#ifndef SHARED_MEMORY_QUEUE_HAZARD_POINTER_HPP
+#define SHARED_MEMORY_QUEUE_HAZARD_POINTER_HPP
+
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SHM_QUEUE_MAGIC 0x5348514845554555ULL
+#define SHM_MAX_PARTICIPANTS 16
+#define SHM_HP_PER_PARTICIPANT 2
+#define SHM_RETIRE_THRESHOLD 64
+// After a scan at most every hazard pointer still holds a retired node, so
+// a list never grows past this
+#define SHM_RETIRED_CAPACITY (SHM_RETIRE_THRESHOLD + SHM_MAX_PARTICIPANTS * SHM_HP_PER_PARTICIPANT)
+#define SHM_SLOT_FREE 0
+#define SHM_OFFSET_MASK 0xffffffffULL
+
+// Michael-Scott queue in a POSIX shared memory segment, for processes on one
+// host to pass items of a trivially copyable T without pipes or sockets.
+// Every process maps the segment wherever it likes, so nodes link through
+// their byte offsets from the start of the segment, 0 being null.
+//
+// Reclamation is Queue_HazardPointer's, with everything kept in the segment:
+// each handle owns a participant slot with SHM_HP_PER_PARTICIPANT hazard
+// offsets (0 head or tail, 1 its successor) and a fixed-size retired list,
+// scanned every SHM_RETIRE_THRESHOLD retires. Free nodes sit on a Treiber
+// stack whose top carries a tag against ABA, which limits the segment to
+// 4GB.
+//
+// A slot records its owner's pid. When a process dies, whoever next attaches
+// or runs out of nodes finds the pid gone, clears the slot's hazards, frees
+// what it can of its retired list and leaves the rest parked in the slot for
+// the next handle to take over. A process killed in the middle of an
+// operation leaks at most the one node that operation was holding.
+//
+// A handle is used by one thread at a time; threads open a handle each.
+template<typename T>
+class SharedMemoryQueue_HazardPointer {
+    static_assert(std::is_trivially_copyable<T>::value, "items are copied between processes");
+
+private:
+    struct Node {
+        std::atomic<uint64_t> next;
+        T item;
+    };
+
+    // pid is the owner's, minus the pid of a process recovering the slot,
+    // or SHM_SLOT_FREE. The retired list is changed in an order that a
+    // process dying part way through can only leak an entry, never leave one
+    // listed twice.
+    struct alignas(64) Participant {
+        std::atomic<int32_t> pid;
+        std::atomic<uint64_t> hazards[SHM_HP_PER_PARTICIPANT];
+        std::atomic<uint32_t> retiredCount;
+        std::atomic<uint64_t> retired[SHM_RETIRED_CAPACITY];
+    };
+
+    // Zero-filled by ftruncate before the creator fills it in
+    struct Segment {
+        uint64_t magic;
+        uint64_t itemSize;
+        uint64_t capacity;
+        std::atomic<uint32_t> ready;
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+        // Tag in the high 32 bits, offset of the top node in the low 32
+        alignas(64) std::atomic<uint64_t> freeList;
+        Participant participants[SHM_MAX_PARTICIPANTS];
+    };
+
+    static constexpr uint64_t nodesOffset = (sizeof(Segment) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+
+    char* base;
+    size_t mappedSize;
+    Segment* segment;
+    Participant* self;
+    int32_t pid;
+
+    static size_t segmentSize(uint64_t capacity)
+    {
+        return nodesOffset + capacity * sizeof(Node);
+    }
+
+    static std::runtime_error error(const std::string& what)
+    {
+        return std::runtime_error("SharedMemoryQueue: " + what + ": " + std::strerror(errno));
+    }
+
+    Node* nodeAt(uint64_t offset) { return (Node*)(base + offset); }
+
+    void initialize(uint64_t capacity)
+    {
+        segment->itemSize = sizeof(T);
+        segment->capacity = capacity;
+        // The first node is the sentinel, the rest start out free
+        uint64_t sentinel = nodesOffset;
+        nodeAt(sentinel)->next.store(0, std::memory_order_relaxed);
+        segment->head.store(sentinel, std::memory_order_relaxed);
+        segment->tail.store(sentinel, std::memory_order_relaxed);
+        for (uint64_t i = 1; i < capacity; i++) {
+            uint64_t next = i + 1 < capacity ? nodesOffset + (i + 1) * sizeof(Node) : 0;
+            nodeAt(nodesOffset + i * sizeof(Node))->next.store(next, std::memory_order_relaxed);
+        }
+        segment->freeList.store(capacity > 1 ? nodesOffset + sizeof(Node) : 0, std::memory_order_relaxed);
+        segment->magic = SHM_QUEUE_MAGIC;
+        segment->ready.store(1, std::memory_order_release);
+    }
+
+    uint64_t allocNode()
+    {
+        while (true) {
+            uint64_t top = segment->freeList.load();
+            uint64_t offset = top & SHM_OFFSET_MASK;
+            if (offset == 0) {
+                return 0;
+            }
+            // May read a node another process has just taken; the tag then
+            // makes the CAS fail
+            uint64_t next = nodeAt(offset)->next.load();
+            uint64_t newTop = (((top >> 32) + 1) << 32) | (next & SHM_OFFSET_MASK);
+            if (segment->freeList.compare_exchange_strong(top, newTop)) {
+                return offset;
+            }
+        }
+    }
+
+    void freeNode(uint64_t offset)
+    {
+        uint64_t top = segment->freeList.load();
+        while (true) {
+            nodeAt(offset)->next.store(top & SHM_OFFSET_MASK);
+            uint64_t newTop = (((top >> 32) + 1) << 32) | offset;
+            if (segment->freeList.compare_exchange_strong(top, newTop)) {
+                return;
+            }
+        }
+    }
+
+    uint64_t protect(int index, const std::atomic<uint64_t>& src)
+    {
+        uint64_t offset = src.load();
+        while (true) {
+            self->hazards[index].store(offset);
+            uint64_t again = src.load();
+            if (again == offset) {
+                return offset;
+            }
+            offset = again;
+        }
+    }
+
+    void clear(Participant* participant)
+    {
+        for (int i = 0; i < SHM_HP_PER_PARTICIPANT; i++) {
+            participant->hazards[i].store(0, std::memory_order_release);
+        }
+    }
+
+    // Frees the nodes on participant's retired list that no slot protects
+    void scan(Participant* participant)
+    {
+        uint64_t hazards[SHM_MAX_PARTICIPANTS * SHM_HP_PER_PARTICIPANT];
+        int count = 0;
+        for (int p = 0; p < SHM_MAX_PARTICIPANTS; p++) {
+            for (int i = 0; i < SHM_HP_PER_PARTICIPANT; i++) {
+                uint64_t offset = segment->participants[p].hazards[i].load();
+                if (offset != 0) {
+                    hazards[count++] = offset;
+                }
+            }
+        }
+        std::sort(hazards, hazards + count);
+        uint32_t retiredCount = participant->retiredCount.load();
+        for (uint32_t i = retiredCount; i-- > 0; ) {
+            uint64_t offset = participant->retired[i].load();
+            if (std::binary_search(hazards, hazards + count, offset)) {
+                continue;
+            }
+            // Drop the last entry from the list, move it over this one and
+            // only then free this one
+            uint64_t last = participant->retired[retiredCount - 1].load();
+            participant->retiredCount.store(--retiredCount);
+            participant->retired[i].store(last);
+            freeNode(offset);
+        }
+    }
+
+    void retire(uint64_t offset)
+    {
+        uint32_t retiredCount = self->retiredCount.load();
+        self->retired[retiredCount].store(offset);
+        self->retiredCount.store(retiredCount + 1);
+        if (retiredCount + 1 >= SHM_RETIRE_THRESHOLD) {
+            scan(self);
+        }
+    }
+
+    void attach()
+    {
+        recoverDeadParticipants();
+        for (int p = 0; p < SHM_MAX_PARTICIPANTS; p++) {
+            int32_t expected = SHM_SLOT_FREE;
+            if (segment->participants[p].pid.compare_exchange_strong(expected, pid)) {
+                self = &segment->participants[p];
+                return;
+            }
+        }
+        errno = EUSERS;
+        throw error("more than SHM_MAX_PARTICIPANTS handles attached");
+    }
+
+public:
+    // Opens the segment called name, creating it with room for capacity
+    // nodes if it does not exist yet, and attaches a participant slot
+    SharedMemoryQueue_HazardPointer(const std::string& name, uint64_t capacity) : base{nullptr}, self{nullptr}, pid{(int32_t)getpid()}
+    {
+        if (capacity < 2 || segmentSize(capacity) > SHM_OFFSET_MASK) {
+            errno = EINVAL;
+            throw error("capacity must be at least 2 and the segment under 4GB");
+        }
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        bool creator = fd >= 0;
+        if (creator) {
+            mappedSize = segmentSize(capacity);
+            if (ftruncate(fd, mappedSize) != 0) {
+                int saved = errno;
+                close(fd);
+                shm_unlink(name.c_str());
+                errno = saved;
+                throw error("ftruncate " + name);
+            }
+        } else {
+            if (errno != EEXIST || (fd = shm_open(name.c_str(), O_RDWR, 0600)) < 0) {
+                throw error("shm_open " + name);
+            }
+            // The creator may not have sized it yet
+            struct stat st;
+            while (true) {
+                if (fstat(fd, &st) != 0) {
+                    int saved = errno;
+                    close(fd);
+                    errno = saved;
+                    throw error("fstat " + name);
+                }
+                if ((size_t)st.st_size >= sizeof(Segment)) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            mappedSize = st.st_size;
+        }
+        void* mapped = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            throw error("mmap " + name);
+        }
+        base = (char*)mapped;
+        segment = (Segment*)base;
+        if (creator) {
+            initialize(capacity);
+        } else {
+            while (segment->ready.load(std::memory_order_acquire) == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (segment->magic != SHM_QUEUE_MAGIC || segment->itemSize != sizeof(T) || mappedSize < segmentSize(segment->capacity)) {
+                munmap(base, mappedSize);
+                errno = EINVAL;
+                throw error(name + " holds a different queue");
+            }
+        }
+        attach();
+    }
+
+    // Releases the slot; nodes still retired stay parked in it for the next
+    // handle
+    ~SharedMemoryQueue_HazardPointer()
+    {
+        clear(self);
+        scan(self);
+        self->pid.store(SHM_SLOT_FREE);
+        munmap(base, mappedSize);
+    }
+
+    SharedMemoryQueue_HazardPointer(const SharedMemoryQueue_HazardPointer&) = delete;
+    SharedMemoryQueue_HazardPointer& operator=(const SharedMemoryQueue_HazardPointer&) = delete;
+
+    // Removes the name; processes that have it mapped keep using it
+    static void unlink(const std::string& name)
+    {
+        shm_unlink(name.c_str());
+    }
+
+    // Returns false when no free node is left
+    bool enqueue(const T& item)
+    {
+        uint64_t offset = allocNode();
+        if (offset == 0) {
+            scan(self);
+            recoverDeadParticipants();
+            offset = allocNode();
+            if (offset == 0) {
+                return false;
+            }
+        }
+        Node* node = nodeAt(offset);
+        node->item = item;
+        node->next.store(0, std::memory_order_relaxed);
+        while (true) {
+            uint64_t last = protect(0, segment->tail);
+            uint64_t next = nodeAt(last)->next.load();
+            if (last != segment->tail.load()) {
+                continue;
+            }
+            if (next == 0) {
+                if (nodeAt(last)->next.compare_exchange_strong(next, offset)) {
+                    segment->tail.compare_exchange_strong(last, offset);
+                    clear(self);
+                    return true;
+                }
+            } else {
+                segment->tail.compare_exchange_strong(last, next);
+            }
+        }
+    }
+
+    // Returns false when the queue is empty
+    bool dequeue(T& item)
+    {
+        while (true) {
+            uint64_t first = protect(0, segment->head);
+            uint64_t last = segment->tail.load();
+            uint64_t next = protect(1, nodeAt(first)->next);
+            if (first != segment->head.load()) {
+                continue;
+            }
+            if (next == 0) {
+                clear(self);
+                return false;
+            }
+            if (first == last) {
+                segment->tail.compare_exchange_strong(last, next);
+                continue;
+            }
+            item = nodeAt(next)->item;
+            if (segment->head.compare_exchange_strong(first, next)) {
+                clear(self);
+                retire(first);
+                return true;
+            }
+        }
+    }
+
+    // Frees the slots of processes that are gone, as described above, and
+    // finishes recoveries whose process died too
+    void recoverDeadParticipants()
+    {
+        for (int p = 0; p < SHM_MAX_PARTICIPANTS; p++) {
+            Participant* participant = &segment->participants[p];
+            int32_t owner = participant->pid.load();
+            int32_t holder = owner < 0 ? -owner : owner;
+            if (owner == SHM_SLOT_FREE || holder == pid || kill(holder, 0) == 0 || errno != ESRCH) {
+                continue;
+            }
+            if (!participant->pid.compare_exchange_strong(owner, -pid)) {
+                continue;
+            }
+            clear(participant);
+            scan(participant);
+            participant->pid.store(SHM_SLOT_FREE);
+        }
+    }
+
+    uint64_t getRetiredCount()
+    {
+        return self->retiredCount.load();
+    }
+};
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef STACK_SHARED_HAZARD_POINTER_HPP
+#define STACK_SHARED_HAZARD_POINTER_HPP
+
+#include "../generic/Stack.hpp"
+
+// Hazard pointers from the process-wide SharedHazardDomain
+template<typename T>
+using Stack_SharedHazardPointer = Stack<T, SharedHazardPointerReclaimer>;
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef WAIT_FREE_QUEUE_HAZARD_POINTER_HPP
+#define WAIT_FREE_QUEUE_HAZARD_POINTER_HPP
+
+#include "../generic/WaitFreeQueue.hpp"
+
+template<typename T>
+using WaitFreeQueue_HazardPointer = WaitFreeQueue<T, HazardPointerReclaimer>;
+
+#endif
@@ -9,6 +9,7 @@
 #define MAX_NUMBER_OF_HAZARD_POINTERS_PER_THREAD 5
 #define MAX_NUMBER_OF_THREADS 40
 #define RETIRED_NODES_THRESHOLD 0
+#define HPPP_FRONTIER_INDEX (MAX_NUMBER_OF_HAZARD_POINTERS_PER_THREAD-1)
 #define TOTAL_NUMBER_OF_HAZARD_POINTERS MAX_NUMBER_OF_THREADS*MAX_NUMBER_OF_HAZARD_POINTERS_PER_THREAD
 
 template<typename T>
@@ -64,36 +65,101 @@ public:
 		return ret;
     }
 
+    // HP++ extension. Nodes using it carry an atomic<bool> `invalidated` and
+    // an atomic<T*> `next` whose bit 0 is the deletion mark.
+    //
+    // Protects the node in ptr, read from the link src inside srcNode, and
+    // validates it without requiring srcNode to still be reachable: it is
+    // enough that srcNode has not been invalidated by an unlinker yet.
+    // Returns false if it has, in which case the traversal must restart.
+    bool tryProtect(int index, T*& ptr, const std::atomic<T*>& src, T* srcNode, const int tid) {
+        while (true) {
+            hazardPointerList[tid][index].store((T*)((size_t)ptr & ~0x1));
+            if (srcNode != nullptr && srcNode->invalidated.load()) {
+                return false;
+            }
+            T* ret = src.load();
+            if (ret == ptr) {
+                return true;
+            }
+            ptr = ret;
+        }
+    }
+
+    // Swings link from first to frontier, cutting out the chain of marked
+    // nodes between them. The frontier stays protected until every cut node
+    // is invalidated, so a reader that validated against a cut node before
+    // that still reaches live memory; the cut nodes are then retired.
+    bool tryUnlink(std::atomic<T*>& link, T* first, T* frontier, const int tid) {
+        hazardPointerList[tid][HPPP_FRONTIER_INDEX].store(frontier);
+        T* expected = first;
+        if (!link.compare_exchange_strong(expected, frontier)) {
+            hazardPointerList[tid][HPPP_FRONTIER_INDEX].store(nullptr, std::memory_order_release);
+            return false;
+        }
+        std::vector<T*> unlinked;
+        for (T* node = first; node != frontier; node = (T*)((size_t)node->next.load() & ~0x1)) {
+            unlinked.push_back(node);
+        }
+        for (T* node : unlinked) {
+            node->invalidated.store(true);
+        }
+        hazardPointerList[tid][HPPP_FRONTIER_INDEX].store(nullptr, std::memory_order_release);
+        for (T* node : unlinked) {
+            retireNode(node, tid);
+        }
+        return true;
+    }
+
     void retireNode(T* ptr, const int threadID) {
-        bool deleteNode = true;
         retiredCount[threadID] += 1;
         retiredPointerList[threadID].push_back(ptr);
         if (retiredPointerList[threadID].size() < RETIRED_NODES_THRESHOLD) 
         {  
             return;
         }
-        for (int i = 0; i < retiredPointerList[threadID].size();i++) 
+        emptyRetireList(threadID);
+    }
+
+    // Same as retireNode for each node, with one scan of the slots
+    void retireNodes(const std::vector<T*>& ptrs, const int threadID) {
+        retiredCount[threadID] += ptrs.size();
+        retiredPointerList[threadID].insert(retiredPointerList[threadID].end(), ptrs.begin(), ptrs.end());
+        if (ptrs.empty() || retiredPointerList[threadID].size() < RETIRED_NODES_THRESHOLD) 
+        {  
+            return;
+        }
+        emptyRetireList(threadID);
+    }
+
+    // Compacts the survivors in place, so a scan is linear in the list
+    void emptyRetireList(const int threadID) {
+        std::vector<T*>& retired = retiredPointerList[threadID];
+        size_t kept = 0;
+        for (size_t i = 0; i < retired.size(); i++) 
         {
-            T* stptr = retiredPointerList[threadID][i];
-            for (int k = 0; k < threadCount; k++) 
-            {
-                for (int j = 0; j < MAX_NUMBER_OF_HAZARD_POINTERS_PER_THREAD; j++) 
-                {
-                    if (hazardPointerList[k][j].load() == stptr) 
-                    {
-                        deleteNode = false;
-                        break;
-                    }
-                }
-            }
-            if (deleteNode) 
+            T* stptr = retired[i];
+            if (isProtected(stptr)) 
             {
-                retiredPointerList[threadID].erase(retiredPointerList[threadID].begin() + i);
-                delete stptr;
-                retiredCount[threadID] -= 1;
+                retired[kept++] = stptr;
                 continue;
             }
+            delete stptr;
+            retiredCount[threadID] -= 1;
+        }
+        retired.resize(kept);
+    }
+
+    // True if any thread has ptr in one of its slots
+    bool isProtected(T* ptr) {
+        for (int k = 0; k < threadCount; k++) {
+            for (int j = 0; j < MAX_NUMBER_OF_HAZARD_POINTERS_PER_THREAD; j++) {
+                if (hazardPointerList[k][j].load() == ptr) {
+                    return true;
+                }
+            }
         }
+        return false;
     }
 
     uint64_t getRetiredCount(int threadID){
@@ -0,0 +1,164 @@
+#ifndef HYALINE_HPP
+#define HYALINE_HPP
+
+#include <iostream>
+#include <atomic>
+#include <vector>
+
+#define MAX_NUMBER_OF_THREADS_HYALINE 40
+#define HYALINE_SLOTS 8
+#define HYALINE_BATCH_SIZE 32
+
+template<typename T>
+class Hyaline{
+
+private:
+    // Each slot head packs, into one word, the newest batch link inserted into
+    // the slot, the number of threads currently inside the slot (HRef) and an
+    // insertion sequence so that a recycled link address is not mistaken for a
+    // thread's handle.
+    static const uint64_t PTR_MASK = (1ULL << 47) - 1;
+    static const uint64_t HREF_ONE = 1ULL << 47;
+    static const uint64_t HREF_MASK = 0x3FULL << 47;
+    static const uint64_t SEQ_ONE = 1ULL << 53;
+
+    struct Batch;
+
+    struct SlotLink {
+        uint64_t next;
+        Batch* batch;
+    };
+
+    struct Batch {
+        std::atomic<int64_t> refs;
+        int owner;
+        std::vector<T*> nodes;
+        SlotLink links[HYALINE_SLOTS];
+
+        Batch(int owner) : refs{0}, owner{owner} { }
+    };
+
+    int numThreads;
+    std::atomic<uint64_t> heads[HYALINE_SLOTS];
+    uint64_t handles[MAX_NUMBER_OF_THREADS_HYALINE];
+    Batch* currentBatch[MAX_NUMBER_OF_THREADS_HYALINE];
+    std::atomic<uint64_t> retiredNodesCount[MAX_NUMBER_OF_THREADS_HYALINE];
+
+public:
+    Hyaline(int threadCount)
+    {
+        numThreads = threadCount;
+        for(int i = 0; i < HYALINE_SLOTS; i++)
+        {
+            heads[i].store(0, std::memory_order_relaxed);
+        }
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_HYALINE; i++)
+        {
+            handles[i] = 0;
+            currentBatch[i] = nullptr;
+            retiredNodesCount[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~Hyaline()
+    {
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_HYALINE; i++)
+        {
+            if(currentBatch[i] != nullptr)
+            {
+                freeBatch(currentBatch[i]);
+            }
+        }
+    }
+
+    void start_op(int threadID)
+    {
+        uint64_t old = heads[threadID % HYALINE_SLOTS].fetch_add(HREF_ONE);
+        handles[threadID] = old & ~HREF_MASK;
+    }
+
+    // Leaving drops the slot's HRef and then releases one reference on every
+    // batch that was inserted into the slot while this thread was inside.
+    void end_op(int threadID)
+    {
+        uint64_t old = heads[threadID % HYALINE_SLOTS].fetch_sub(HREF_ONE);
+        uint64_t curr = old & ~HREF_MASK;
+        while(curr != handles[threadID])
+        {
+            SlotLink* link = (SlotLink*)(curr & PTR_MASK);
+            curr = link->next;
+            releaseBatch(link->batch, 1);
+        }
+    }
+
+    void retireNode(T* obj, int threadID)
+    {
+        if(obj == nullptr)
+        {
+            return;
+        }
+        if(currentBatch[threadID] == nullptr)
+        {
+            currentBatch[threadID] = new Batch(threadID);
+            currentBatch[threadID]->nodes.reserve(HYALINE_BATCH_SIZE);
+        }
+        currentBatch[threadID]->nodes.push_back(obj);
+        retiredNodesCount[threadID].fetch_add(1, std::memory_order_relaxed);
+        if(currentBatch[threadID]->nodes.size() >= HYALINE_BATCH_SIZE)
+        {
+            publishBatch(currentBatch[threadID]);
+            currentBatch[threadID] = nullptr;
+        }
+    }
+
+    uint64_t getRetiredNodeCount(int threadID)
+    {
+        return retiredNodesCount[threadID].load(std::memory_order_relaxed);
+    }
+
+private:
+    // The batch is linked into every slot that has threads inside and its
+    // reference count is credited with their HRef. Empty slots are skipped, so
+    // the cost depends on the number of slots and never on the thread count.
+    void publishBatch(Batch* batch)
+    {
+        int64_t inserted = 0;
+        for(int i = 0; i < HYALINE_SLOTS; i++)
+        {
+            uint64_t old = heads[i].load();
+            while((old & HREF_MASK) != 0)
+            {
+                batch->links[i].next = old & ~HREF_MASK;
+                batch->links[i].batch = batch;
+                uint64_t link = ((old & ~PTR_MASK) + SEQ_ONE) | (uint64_t)&batch->links[i];
+                if(heads[i].compare_exchange_strong(old, link))
+                {
+                    inserted += (old & HREF_MASK) / HREF_ONE;
+                    break;
+                }
+            }
+        }
+        releaseBatch(batch, -inserted);
+    }
+
+    // Threads leaving a slot may release a batch before the retirer credits it,
+    // so the count is allowed to go negative and hits zero exactly once.
+    void releaseBatch(Batch* batch, int64_t count)
+    {
+        if(batch->refs.fetch_sub(count) == count)
+        {
+            freeBatch(batch);
+        }
+    }
+
+    void freeBatch(Batch* batch)
+    {
+        for(auto node : batch->nodes)
+        {
+            delete node;
+        }
+        retiredNodesCount[batch->owner].fetch_sub(batch->nodes.size(), std::memory_order_relaxed);
+        delete batch;
+    }
+};
+#endif
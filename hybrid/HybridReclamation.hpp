@@ -0,0 +1,269 @@
+#ifndef HYBRID_RECLAMATION_HPP
+#define HYBRID_RECLAMATION_HPP
+
+#include <iostream>
+#include <atomic>
+#include <vector>
+#include <chrono>
+#include "../hazardpointer/hazardpointer.hpp"
+
+#define MAX_NUMBER_OF_THREADS_HYBRID 40
+#define HYBRID_EPOCH_FREQUENCY 150
+#define HYBRID_RECLAIM_FREQUENCY 30
+#define HYBRID_MAX_HOPS 256
+#define HYBRID_MAX_CRITICAL_US 100
+#define HYBRID_CLOCK_CHECK_HOPS 32
+
+// Operations start under an IBR-style reservation interval, kept here with
+// the epoch clock that stamps nodes: its lower end is the epoch at start_op and its upper end is raised by read to the epoch current
+// at each pointer load, so nodes born during the operation are covered too. A
+// traversal that has made HYBRID_MAX_HOPS hops, or has been inside its
+// operation for longer than HYBRID_MAX_CRITICAL_US, moves to hazard pointers:
+// it publishes the nodes it currently holds and only then drops its
+// reservation, so a long scan no longer holds back every node retired after
+// its start epoch. The list checks hop once per node it walks; the stack
+// and queue once per retry of their CAS loops, and read their shared
+// pointers through protect, which publishes and validates them once the
+// thread is in hazard pointer mode.
+//
+// A retired node is freed once neither check of the two domains keeps it:
+// no reservation interval overlaps its lifetime and no hazard pointer points
+// at it. Reservations are read before the hazard pointers, the opposite order
+// to the switch, so a thread caught in the middle is seen by at least one.
+template<typename T>
+class HybridReclamation{
+
+private:
+    int numThreads;
+    std::atomic<uint64_t> globalEpoch{0};
+    hazardPointers<T> hp;
+    uint64_t allocStat[MAX_NUMBER_OF_THREADS_HYBRID];
+    std::atomic<uint64_t> lowerEpoch[MAX_NUMBER_OF_THREADS_HYBRID];
+    std::atomic<uint64_t> upperEpoch[MAX_NUMBER_OF_THREADS_HYBRID];
+    bool hazardMode[MAX_NUMBER_OF_THREADS_HYBRID];
+    uint64_t hops[MAX_NUMBER_OF_THREADS_HYBRID];
+    std::chrono::steady_clock::time_point opStart[MAX_NUMBER_OF_THREADS_HYBRID];
+    std::vector<T*> retiredList[MAX_NUMBER_OF_THREADS_HYBRID];
+    uint64_t retireStat[MAX_NUMBER_OF_THREADS_HYBRID];
+    uint64_t retiredNodesCount[MAX_NUMBER_OF_THREADS_HYBRID];
+
+public:
+    HybridReclamation(int threadCount) :
+        numThreads{threadCount},
+        hp{threadCount}
+    {
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_HYBRID; i++)
+        {
+            lowerEpoch[i].store(UINT64_MAX, std::memory_order_relaxed);
+            upperEpoch[i].store(0, std::memory_order_relaxed);
+            hazardMode[i] = false;
+            hops[i] = 0;
+            allocStat[i] = 0;
+            retireStat[i] = 0;
+            retiredNodesCount[i] = 0;
+        }
+    }
+
+    ~HybridReclamation()
+    {
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_HYBRID; i++)
+        {
+            for(auto node : retiredList[i])
+            {
+                delete node;
+            }
+        }
+    }
+
+    // Advances the epoch every HYBRID_EPOCH_FREQUENCY allocations of a
+    // thread and stamps the node with it
+    T* allocNode(int threadID, T* obj)
+    {
+        allocStat[threadID] += 1;
+        if(allocStat[threadID] % HYBRID_EPOCH_FREQUENCY == 0)
+        {
+            globalEpoch.fetch_add(1, std::memory_order_acq_rel);
+        }
+        obj->birth_epoch = getGlobalEpoch();
+        return obj;
+    }
+
+    void start_op(int threadID)
+    {
+        hazardMode[threadID] = false;
+        hops[threadID] = 0;
+        opStart[threadID] = std::chrono::steady_clock::now();
+        uint64_t e = getGlobalEpoch();
+        upperEpoch[threadID].store(e, std::memory_order_seq_cst);
+        lowerEpoch[threadID].store(e, std::memory_order_seq_cst);
+    }
+
+    void end_op(int threadID)
+    {
+        if(hazardMode[threadID])
+        {
+            hp.clear(threadID);
+            hazardMode[threadID] = false;
+        }
+        else
+        {
+            lowerEpoch[threadID].store(UINT64_MAX, std::memory_order_seq_cst);
+        }
+    }
+
+    // Loads a shared pointer. Under the reservation, raises its upper end
+    // until the epoch is the same before and after the load, so the node
+    // read was born inside the interval. In hazard pointer mode it is a plain
+    // load that the caller publishes and validates.
+    T* read(const std::atomic<T*>& src, int threadID)
+    {
+        if(hazardMode[threadID])
+        {
+            return src.load();
+        }
+        uint64_t upper = upperEpoch[threadID].load(std::memory_order_relaxed);
+        while(true)
+        {
+            T* ptr = src.load();
+            uint64_t e = getGlobalEpoch();
+            if(e == upper)
+            {
+                return ptr;
+            }
+            upper = e;
+            upperEpoch[threadID].store(e, std::memory_order_seq_cst);
+        }
+    }
+
+    // read, plus in hazard pointer mode publishing the pointer in slot index
+    // and reloading src until it still holds it
+    T* protect(int index, const std::atomic<T*>& src, int threadID)
+    {
+        if(!hazardMode[threadID])
+        {
+            return read(src, threadID);
+        }
+        T* ptr = src.load();
+        while(true)
+        {
+            hp.storeHazardPtr(index, ptr, threadID);
+            T* again = src.load();
+            if(again == ptr)
+            {
+                return ptr;
+            }
+            ptr = again;
+        }
+    }
+
+    bool isHazardMode(int threadID)
+    {
+        return hazardMode[threadID];
+    }
+
+    // Counts one hop of a traversal; true once the thread should move to
+    // hazard pointers. The clock is only read every few hops.
+    bool hop(int threadID)
+    {
+        if(hazardMode[threadID])
+        {
+            return false;
+        }
+        hops[threadID] += 1;
+        if(hops[threadID] >= HYBRID_MAX_HOPS)
+        {
+            return true;
+        }
+        if(hops[threadID] % HYBRID_CLOCK_CHECK_HOPS == 0)
+        {
+            auto elapsed = std::chrono::steady_clock::now() - opStart[threadID];
+            return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() >= HYBRID_MAX_CRITICAL_US;
+        }
+        return false;
+    }
+
+    // Must be called while the reservation still covers the given nodes
+    void switchToHazardPointers(int threadID, T* n0, T* n1, T* n2)
+    {
+        hp.storeHazardPtr(0, n0, threadID);
+        hp.storeHazardPtr(1, n1, threadID);
+        hp.storeHazardPtr(2, n2, threadID);
+        lowerEpoch[threadID].store(UINT64_MAX, std::memory_order_seq_cst);
+        hazardMode[threadID] = true;
+    }
+
+    // Slot writes are skipped while the thread is still running on its
+    // reservation
+    void storeHazardPtr(int index, T* ptr, int threadID)
+    {
+        if(hazardMode[threadID])
+        {
+            hp.storeHazardPtr(index, ptr, threadID);
+        }
+    }
+
+    void retireNode(T* obj, int threadID)
+    {
+        if(obj == nullptr)
+        {
+            return;
+        }
+        obj->retire_epoch = getGlobalEpoch();
+        retiredList[threadID].push_back(obj);
+        retiredNodesCount[threadID] += 1;
+        if(retireStat[threadID] % HYBRID_RECLAIM_FREQUENCY == 0)
+        {
+            emptyRetireList(threadID);
+        }
+        retireStat[threadID] += 1;
+    }
+
+    void emptyRetireList(int threadID)
+    {
+        uint64_t lower[numThreads];
+        uint64_t upper[numThreads];
+        for(int i = 0; i < numThreads; i++)
+        {
+            lower[i] = lowerEpoch[i].load(std::memory_order_seq_cst);
+            upper[i] = upperEpoch[i].load(std::memory_order_seq_cst);
+        }
+        std::vector<T*>& list = retiredList[threadID];
+        size_t kept = 0;
+        for(size_t i = 0; i < list.size(); i++)
+        {
+            T* node = list[i];
+            if(conflict(lower, upper, node) || hp.isProtected(node))
+            {
+                list[kept++] = node;
+                continue;
+            }
+            delete node;
+            retiredNodesCount[threadID] -= 1;
+        }
+        list.resize(kept);
+    }
+
+    uint64_t getRetiredNodeCount(int threadID)
+    {
+        return retiredNodesCount[threadID];
+    }
+
+private:
+    uint64_t getGlobalEpoch()
+    {
+        return globalEpoch.load(std::memory_order_acquire);
+    }
+
+    bool conflict(uint64_t* lower, uint64_t* upper, T* node)
+    {
+        for(int i = 0; i < numThreads; i++)
+        {
+            if(lower[i] <= node->retire_epoch && upper[i] >= node->birth_epoch)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+#endif
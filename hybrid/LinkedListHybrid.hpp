@@ -0,0 +1,210 @@
+#ifndef LINKED_LIST_HYBRID_HPP
+#define LINKED_LIST_HYBRID_HPP
+
+#include <atomic>
+#include <iostream>
+#include "HybridReclamation.hpp"
+
+template<typename T>
+class LinkedList_Hybrid {
+
+private:
+    struct Node {
+        T* item;
+        uint64_t birth_epoch;
+        uint64_t retire_epoch;
+        std::atomic<Node*> next;
+
+        Node(T* item) 
+        { 
+            this->item = item;
+            this->next.store(nullptr);
+            this->birth_epoch = 0;
+            this->retire_epoch = 0;
+        }
+    };
+
+    bool isMarked(Node * node) {
+    	return ((size_t) node & 0x1);
+    }
+
+    Node * getMarked(Node * node) {
+    	return (Node*)((size_t) node | 0x1);
+    }
+
+    Node * getUnmarked(Node * node) {
+    	return (Node*)((size_t) node & (~0x1));
+    }
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    int numThreads;
+    HybridReclamation<Node> hybridList {numThreads};
+
+public:
+
+    LinkedList_Hybrid(int numThreads) : numThreads{numThreads}
+    {
+        Node* sentinel = new Node(nullptr);
+        head.store(sentinel);
+        tail.store(sentinel);
+        head.load()->next.store(tail.load());
+    }
+
+    ~LinkedList_Hybrid()
+    {
+        Node* node = getUnmarked(head.load());
+        while(node != tail.load())
+        {
+            Node* next = getUnmarked(node->next.load());
+            delete node;
+            node = next;
+        }
+        delete tail.load();
+    }
+
+    bool add(T* item, int threadID)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        Node* node = new Node(item);
+        node = hybridList.allocNode(threadID, node);
+        hybridList.start_op(threadID);
+        while (true) {
+            if (find(item, &pred, &curr, &next, threadID)) 
+            {
+                delete node;
+                hybridList.end_op(threadID);
+                return false;
+            }
+            node->next.store(curr, std::memory_order_relaxed);
+            Node *temp = curr;
+            if (pred->compare_exchange_strong(temp, node)) 
+            {
+                hybridList.end_op(threadID);
+                return true;
+            }
+        }
+    }
+
+    bool remove(T* item, int threadID)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        hybridList.start_op(threadID);
+        while (true) 
+        {
+            if (!find(item, &pred, &curr, &next, threadID)) {
+                hybridList.end_op(threadID);
+                return false;
+            }
+            Node *temp = getUnmarked(next);
+            if (!curr->next.compare_exchange_strong(temp, getMarked(next))) {
+                continue;
+            }
+            temp = curr;
+            if (pred->compare_exchange_strong(temp, getUnmarked(next))) 
+            {
+                hybridList.retireNode(curr, threadID);
+            }
+            hybridList.end_op(threadID);
+            return true;
+        }
+    }
+
+    bool contains (T* item, int threadID)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        hybridList.start_op(threadID);
+        bool found = find(item, &pred, &curr, &next, threadID);
+        hybridList.end_op(threadID);
+        return found;
+    }
+
+    uint64_t getRetiredCountLinkedList(int threadID)
+    {
+        return hybridList.getRetiredNodeCount(threadID);
+    }
+
+
+private:
+
+    // Runs under the caller's reservation until hybridList.hop says the
+    // traversal has gone on too long; from then on curr, pred's node and next
+    // sit in hazard pointer slots 1, 2 and 0. The pred/curr validation below
+    // is what makes the published next safe in that mode. curr is always
+    // unmarked.
+    bool find (T* item, std::atomic<Node*> **par_pred, Node **par_curr, Node **par_next, const int threadID)
+    {
+        std::atomic<Node*> *pred;
+        Node *predNode, *curr, *next;
+     try_again:
+        pred = &head;
+        predNode = nullptr;
+        next = nullptr;
+        curr = hybridList.read(head, threadID);
+        if (hybridList.isHazardMode(threadID)) 
+        {
+            hybridList.storeHazardPtr(1, curr, threadID);
+            if (head.load() != curr) 
+            {
+                goto try_again;
+            }
+        }
+        while (true) {
+            if (curr == nullptr) 
+            {
+                break;
+            }
+            if (hybridList.hop(threadID)) 
+            {
+                hybridList.switchToHazardPointers(threadID, nullptr, curr, predNode);
+            }
+            next = hybridList.read(curr->next, threadID);
+            hybridList.storeHazardPtr(0, getUnmarked(next), threadID);
+            if (curr->next.load() != next) 
+            {
+                goto try_again;
+            }
+            if (pred->load() != curr) 
+            {
+                goto try_again;
+            }
+            if (getUnmarked(next) == tail.load()) 
+            {
+                break;
+            }
+            if (!isMarked(next)) 
+            {
+                if (curr->item != nullptr && !(*curr->item < *item)) 
+                {
+                    *par_curr = curr;
+                    *par_pred = pred;
+                    *par_next = next;
+                    return (*curr->item == *item);
+                }
+                pred = &curr->next;
+                predNode = curr;
+                hybridList.storeHazardPtr(2, predNode, threadID);
+            } 
+            else 
+            {
+                Node *temp = curr;
+                if (!pred->compare_exchange_strong(temp, getUnmarked(next))) 
+                {
+                    goto try_again;
+                }
+                hybridList.retireNode(curr, threadID);
+            }
+            curr = getUnmarked(next);
+            hybridList.storeHazardPtr(1, curr, threadID);
+        }
+        *par_curr = curr;
+        *par_pred = pred;
+        *par_next = next;
+        return false;
+    }
+};
+
+#endif
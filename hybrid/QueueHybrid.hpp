@@ -0,0 +1,217 @@
+#ifndef QUEUE_HYBRID_HPP
+#define QUEUE_HYBRID_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "HybridReclamation.hpp"
+
+using namespace std;
+
+template<typename T>
+class Queue_Hybrid
+{
+
+private:
+    struct Node{
+        T* item;
+        uint64_t birth_epoch;
+        uint64_t retire_epoch;
+        std:: atomic<Node*> next;
+
+        Node(T* item) 
+        {
+            this->item = item;
+            next.store(nullptr);
+            birth_epoch = 0;
+            retire_epoch = 0;
+        }
+
+        bool casNext(Node *cmp, Node *val) {
+            return next.compare_exchange_strong(cmp, val);
+        }
+    };
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    const int numOfThreads;
+    HybridReclamation<Node> hybridQueue{numOfThreads};
+
+public:
+
+    Queue_Hybrid(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = new Node(nullptr);
+        head.store(sentinel, std::memory_order_relaxed);
+        tail.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~Queue_Hybrid(){
+        while(dequeue(0) != nullptr);
+        delete head.load();
+    }
+
+    bool enqueue(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = new Node(item);
+        node = hybridQueue.allocNode(threadID,node);
+        hybridQueue.start_op(threadID);
+        while(true)
+        {
+            if (hybridQueue.hop(threadID)) 
+            {
+                hybridQueue.switchToHazardPointers(threadID, nullptr, nullptr, nullptr);
+            }
+            Node* temp = hybridQueue.protect(0, tail, threadID);
+            if (temp == tail.load()) 
+            {
+                Node* next  = temp->next.load();
+                if (next == nullptr) 
+                {
+                    if (temp->casNext(nullptr, node)) 
+                    {
+                        tail.compare_exchange_strong(temp, node);
+                        hybridQueue.end_op(threadID);
+                        return true;
+                    }
+                } 
+                else 
+                {
+                    tail.compare_exchange_strong(temp, next);
+                }
+            }
+        }
+    }
+
+    // Protects head in slot 0 and its successor in slot 1, and validates
+    // head again before next is used, so both hold in hazard pointer mode
+    T* dequeue(int threadID)
+    {
+        hybridQueue.start_op(threadID);
+        while (true) 
+        {
+            if (hybridQueue.hop(threadID)) 
+            {
+                hybridQueue.switchToHazardPointers(threadID, nullptr, nullptr, nullptr);
+            }
+            Node* node = hybridQueue.protect(0, head, threadID);
+            Node* next = hybridQueue.protect(1, node->next, threadID);
+            if (head.load() != node) 
+            {
+                continue;
+            }
+            if (next == nullptr) 
+            {
+                hybridQueue.end_op(threadID);
+                return nullptr;
+            }
+            Node* last = tail.load();
+            if (node == last) 
+            {
+                tail.compare_exchange_strong(last, next);
+                continue;
+            }
+            if (head.compare_exchange_strong(node, next)) 
+            {
+                T* item = next->item;
+                hybridQueue.retireNode(node, threadID);
+                hybridQueue.end_op(threadID);
+                return item;
+            }
+        }
+    }
+
+    // Links the items into a private chain, appends it with one CAS on the
+    // last node's next and then swings tail to the end of the chain. Null
+    // items are skipped.
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last, int threadID)
+    {
+        Node* chainFirst = nullptr;
+        Node* chainLast = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = hybridQueue.allocNode(threadID, new Node(*first));
+            if(chainLast == nullptr)
+            {
+                chainFirst = node;
+            }
+            else
+            {
+                chainLast->next.store(node, std::memory_order_relaxed);
+            }
+            chainLast = node;
+        }
+        if(chainFirst == nullptr)
+        {
+            return false;
+        }
+        hybridQueue.start_op(threadID);
+        while(true)
+        {
+            if (hybridQueue.hop(threadID)) 
+            {
+                hybridQueue.switchToHazardPointers(threadID, nullptr, nullptr, nullptr);
+            }
+            Node* temp = hybridQueue.protect(0, tail, threadID);
+            Node* next  = temp->next.load();
+            if (temp == tail.load()) 
+            {
+                if (next == nullptr) 
+                {
+                    if (temp->casNext(nullptr, chainFirst)) 
+                    {
+                        tail.compare_exchange_strong(temp, chainLast);
+                        hybridQueue.end_op(threadID);
+                        return true;
+                    }
+                } 
+                else 
+                {
+                    tail.compare_exchange_strong(temp, next);
+                }
+            }
+        }
+    }
+
+    // One dequeue per item: in hazard pointer mode the nodes past head are
+    // not protected, so they cannot be walked to detach several at once
+    int dequeueBatch(int n, T** out, int threadID)
+    {
+        int count = 0;
+        while(count < n)
+        {
+            T* item = dequeue(threadID);
+            if(item == nullptr)
+            {
+                break;
+            }
+            out[count++] = item;
+        }
+        return count;
+    }
+
+    std::vector<T*> drain(int threadID)
+    {
+        std::vector<T*> items;
+        while(T* item = dequeue(threadID))
+        {
+            items.push_back(item);
+        }
+        return items;
+    }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return hybridQueue.getRetiredNodeCount(threadID);
+    }
+};
+
+#endif
\ No newline at end of file
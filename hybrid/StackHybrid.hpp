@@ -0,0 +1,204 @@
+#ifndef STACK_HYBRID_HPP
+#define STACK_HYBRID_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "HybridReclamation.hpp"
+
+template<typename T>
+class Stack_Hybrid {
+private:
+    struct Node {
+        T* item;
+        uint64_t birth_epoch;
+        uint64_t retire_epoch;
+        std::atomic<Node*> next;
+
+        Node(T* item)
+        {
+            this->item = item;
+            next.store(nullptr);
+            birth_epoch = 0;
+            retire_epoch = 0;
+        }
+    };
+
+    std::atomic<Node*> top;
+    const int numOfThreads;
+    HybridReclamation<Node> hybridStack{numOfThreads};
+
+public:
+
+    Stack_Hybrid(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = new Node(nullptr);
+        top.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~Stack_Hybrid(){
+        while(pop(0) != nullptr);
+        delete top.load();
+    }
+
+    bool push(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = new Node(item);
+        node = hybridStack.allocNode(threadID,node);
+        hybridStack.start_op(threadID);
+        while(true)
+        {
+            Node* temp = top.load();
+            if(temp == top.load())
+            {
+                node->next.store(temp, std::memory_order_relaxed);
+                if(top.compare_exchange_strong(temp,node))
+                {
+                    hybridStack.end_op(threadID);
+                    return true;
+                }
+            }
+        }   
+    }
+
+    T* pop(int threadID)
+    {
+        Node *temp, *next;
+        T* ret_data;
+        hybridStack.start_op(threadID);
+        while(true)
+        {
+            if(hybridStack.hop(threadID))
+            {
+                hybridStack.switchToHazardPointers(threadID, nullptr, nullptr, nullptr);
+            }
+            temp = hybridStack.protect(0, top, threadID);
+            if(temp == nullptr)
+            {
+                hybridStack.end_op(threadID);
+                return nullptr;
+            }
+            if(top.load() != temp)
+            {
+                continue;
+            }
+            next = temp->next.load();
+            if(top.compare_exchange_strong(temp, next))
+            {
+                ret_data = temp->item;
+                hybridStack.retireNode(temp,threadID);
+                hybridStack.end_op(threadID);
+                return ret_data;
+            }
+        }
+    }
+
+    // Links the items into a private chain and splices it onto top with one
+    // CAS, so the last item ends up on top. Null items are skipped.
+    template<typename Iterator>
+    bool pushBatch(Iterator first, Iterator last, int threadID)
+    {
+        Node* bottom = nullptr;
+        Node* chain = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = hybridStack.allocNode(threadID, new Node(*first));
+            node->next.store(chain, std::memory_order_relaxed);
+            if(bottom == nullptr)
+            {
+                bottom = node;
+            }
+            chain = node;
+        }
+        if(chain == nullptr)
+        {
+            return false;
+        }
+        hybridStack.start_op(threadID);
+        while(true)
+        {
+            Node* temp = top.load();
+            bottom->next.store(temp, std::memory_order_relaxed);
+            if(top.compare_exchange_strong(temp,chain))
+            {
+                hybridStack.end_op(threadID);
+                return true;
+            }
+        }
+    }
+
+    // Pops up to n items within one operation. Each node still takes its own
+    // CAS: in hazard pointer mode the nodes below top are not protected, so
+    // they cannot be walked to detach several at once. Stops, like pop, at
+    // the sentinel. Every pass counts as a hop, so a long batch moves to
+    // hazard pointers like a long list traversal.
+    int popBatch(int n, T** out, int threadID)
+    {
+        int count = 0;
+        hybridStack.start_op(threadID);
+        while(count < n)
+        {
+            if(hybridStack.hop(threadID))
+            {
+                hybridStack.switchToHazardPointers(threadID, nullptr, nullptr, nullptr);
+            }
+            Node* temp = hybridStack.protect(0, top, threadID);
+            if(temp == nullptr)
+            {
+                break;
+            }
+            if(top.load() != temp)
+            {
+                continue;
+            }
+            Node* next = temp->next.load();
+            if(top.compare_exchange_strong(temp, next))
+            {
+                T* ret_data = temp->item;
+                hybridStack.retireNode(temp,threadID);
+                if(ret_data == nullptr)
+                {
+                    break;
+                }
+                out[count++] = ret_data;
+            }
+        }
+        hybridStack.end_op(threadID);
+        return count;
+    }
+
+    // Takes the whole stack with one exchange; the detached chain is private
+    // and is retired node by node. Items come out in pop order.
+    std::vector<T*> popAll(int threadID)
+    {
+        std::vector<T*> items;
+        hybridStack.start_op(threadID);
+        Node* node = top.exchange(nullptr);
+        while(node != nullptr)
+        {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            if(node->item != nullptr)
+            {
+                items.push_back(node->item);
+            }
+            hybridStack.retireNode(node,threadID);
+            node = next;
+        }
+        hybridStack.end_op(threadID);
+        return items;
+    }
+
+    uint64_t getRetiredCountStack(int threadID)
+    {
+        return hybridStack.getRetiredNodeCount(threadID);
+    }
+};
+
+#endif
\ No newline at end of file
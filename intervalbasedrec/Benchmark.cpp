@@ -10,7 +10,14 @@
 // Hazard Pointers with different data structures
 #include "LinkedListIBR.hpp"
 #include "QueueIBR.hpp"
+#include "FAAArrayQueueIBR.hpp"
+#include "MultiQueueIBR.hpp"
+#include "FlatCombiningQueueIBR.hpp"
 #include "StackIBR.hpp"
+#include "EliminationStackIBR.hpp"
+
+// The no-reclamation baseline is each container instantiated with
+// LeakReclaimer from generic/Reclaimers.hpp
 
 using namespace std;
 using namespace chrono;
@@ -19,10 +26,25 @@ class Benchmarks {
 
 private:
     int numThreads;
+    long long baselineOps;
 
 public:
     Benchmarks(int numThreads) {
         this->numThreads = numThreads;
+        this->baselineOps = 0;
+    }
+
+    void setBaselineOps(long long ops) {
+        baselineOps = ops;
+    }
+
+    // Best-run throughput, the statistic printed as Ops/sec, as a percentage of
+    // the no-reclamation run once one is set
+    string baselineReport(long long ops) {
+        if (baselineOps <= 0) {
+            return "";
+        }
+        return ", " + to_string((long)(100. * ops / baselineOps)) + "% of no-reclamation";
     }
 
     template<typename Q>
@@ -137,8 +159,8 @@ public:
         // Printed value is the median of the number of ops per second that all threads were able to accomplish (on average)
         // std::cout << "Ops/sec = " << medianops << "   delta = " << delta << "%   min = " << minops << "   max = " << maxops << "\n";
         // std::cout << "Number of Unreclaimed Nodes = " << medianretiredagg << "\n";
-        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<"\n\n";
-        return medianops;
+        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<baselineReport(maxops)<<"\n\n";
+        return maxops;
     }
 
     template<typename S>
@@ -253,9 +275,9 @@ public:
         // std::cout << "Ops/sec = " << medianops << "   delta = " << delta << "%   min = " << minops << "   max = " << maxops << "\n";
         // std::cout << "Number of Unreclaimed Nodes = " << medianretiredagg << "\n";
         
-        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<"\n\n";
+        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<baselineReport(maxops)<<"\n\n";
 
-        return medianops;
+        return maxops;
     }
 
     template<typename L>
@@ -371,9 +393,9 @@ public:
         // std::cout << "Ops/sec = " << medianops << "   delta = " << delta << "%   min = " << minops << "   max = " << maxops << "\n";
         // std::cout << "Number of Unreclaimed Nodes = " << medianretiredagg << "\n";
         
-        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<"\n\n";
+        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<baselineReport(maxops)<<"\n\n";
         
-        return medianops;
+        return maxops;
     }
 };
 
@@ -418,16 +440,53 @@ int main(int argc, char* argv[])
 
             if(strcmp(ds_type, "linkedlist") == 0)
             {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkLinkedList<List<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
                 bench.benchmarkLinkedList<LinkedList_IBR<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
             }
             else if(strcmp(ds_type, "queue") == 0)
             {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<Queue<int, LeakReclaimer, QUEUE_NODE_ALLOCATOR>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
                 bench.benchmarkQueues<Queue_IBR<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
             }
+            else if(strcmp(ds_type, "faaqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<FAAArrayQueue<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<FAAArrayQueue_IBR<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
+            else if(strcmp(ds_type, "multiqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<MultiQueue<int, LeakReclaimer, QUEUE_NODE_ALLOCATOR>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<MultiQueue_IBR<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
+            else if(strcmp(ds_type, "fcqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<FlatCombiningQueue<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<FlatCombiningQueue_IBR<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
             else if(strcmp(ds_type, "stack") == 0)
             {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkStacks<Stack<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
                 bench.benchmarkStacks<Stack_IBR<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
             }
+            else if(strcmp(ds_type, "eliminationstack") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkStacks<EliminationStack<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkStacks<EliminationStack_IBR<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
             else
             {
                 std::cout<<"ERROR: Enter appropriate data structure\n";
@@ -0,0 +1,9 @@
+#ifndef ELIMINATION_STACK_IBR_HPP
+#define ELIMINATION_STACK_IBR_HPP
+
+#include "../generic/EliminationStack.hpp"
+
+template<typename T>
+using EliminationStack_IBR = EliminationStack<T, IBRReclaimer>;
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef FAA_ARRAY_QUEUE_IBR_HPP
+#define FAA_ARRAY_QUEUE_IBR_HPP
+
+#include "../generic/FAAArrayQueue.hpp"
+
+template<typename T>
+using FAAArrayQueue_IBR = FAAArrayQueue<T, IBRReclaimer>;
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef FLAT_COMBINING_QUEUE_IBR_HPP
+#define FLAT_COMBINING_QUEUE_IBR_HPP
+
+#include "../generic/FlatCombiningQueue.hpp"
+
+template<typename T>
+using FlatCombiningQueue_IBR = FlatCombiningQueue<T, IBRReclaimer>;
+
+#endif
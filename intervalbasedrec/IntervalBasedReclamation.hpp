@@ -40,9 +40,20 @@ public:
         }
     }
 
+    ~IntervalBasedReclamation()
+    {
+        for(int i = 0; i < numThreads; i++)
+        {
+            for(auto node : retiredList[i])
+            {
+                delete node;
+            }
+        }
+    }
+
     uint64_t getGlobalEpoch()
     {
-        return globalEpoch.load(std::memory_order_release);
+        return globalEpoch.load(std::memory_order_acquire);
     }
 
     void start_op(int threadID){
@@ -82,6 +93,24 @@ public:
 		retireStat[threadID] += 1;
 	}
 
+    // Same as retireNode for each node, with one scan of the reservations
+    void retireNodes(const std::vector<T*>& objs, int threadID)
+    {
+        if(objs.empty())
+        {
+            return;
+        }
+        uint64_t re = globalEpoch.load(std::memory_order_acquire);
+        for(auto obj : objs)
+        {
+            obj->retire_epoch = re;
+            retiredList[threadID].push_back(obj);
+        }
+        retiredNodesCount[threadID] += objs.size();
+        retireStat[threadID] += objs.size();
+        emptyRetireList(threadID);
+    }
+
     bool conflict(uint64_t* reservEpoch, uint64_t birth_epoch, uint64_t retire_epoch){
 		for (int i = 0; i < numThreads; i++){
 			if (reservEpoch[i] >= birth_epoch && reservEpoch[i] <= retire_epoch){
@@ -91,6 +120,7 @@ public:
 		return false;
 	}
 	
+    // Compacts the survivors in place, so a scan is linear in the list
 	void emptyRetireList(int threadID)
     {
 		uint64_t reservEpoch[numThreads];
@@ -98,18 +128,21 @@ public:
         {
 			reservEpoch[i] = reservations[i].load(std::memory_order_acquire);
 		}
-		for (int i = 0;i < retiredList[threadID].size();i++)
+        std::vector<T*>& retired = retiredList[threadID];
+        size_t kept = 0;
+		for (size_t i = 0; i < retired.size(); i++)
         {
-            auto temp = retiredList[threadID][i];
-			if(!conflict(reservEpoch, temp->birth_epoch, temp->retire_epoch))
+            auto temp = retired[i];
+			if(conflict(reservEpoch, temp->birth_epoch, temp->retire_epoch))
             {
-				retiredList[threadID].erase(retiredList[threadID].begin() + i);
-				delete temp;
-				retireStat[threadID] -= 1;
-                retiredNodesCount[threadID] -= 1;
-                //cout << "Decremented ctr to " << retiredNodesCount[threadID] << endl;
-			}
+                retired[kept++] = temp;
+                continue;
+            }
+			delete temp;
+			retireStat[threadID] -= 1;
+            retiredNodesCount[threadID] -= 1;
 		}
+        retired.resize(kept);
 	}
 
     uint64_t getRetiredNodeCount(int threadID)
@@ -0,0 +1,209 @@
+#ifndef LINKED_LIST_NBR_HPP
+#define LINKED_LIST_NBR_HPP
+
+#include <atomic>
+#include <iostream>
+#include "NeutralizationBasedReclamation.hpp"
+
+template<typename T>
+class LinkedList_NBR {
+
+private:
+    struct Node {
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* item) 
+        { 
+            this->item = item;
+            this->next.store(nullptr);
+        }
+    };
+
+    bool isMarked(Node * node) {
+    	return ((size_t) node & 0x1);
+    }
+
+    Node * getMarked(Node * node) {
+    	return (Node*)((size_t) node | 0x1);
+    }
+
+    Node * getUnmarked(Node * node) {
+    	return (Node*)((size_t) node & (~0x1));
+    }
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    int numThreads;
+    NeutralizationBasedReclamation<Node> nbrList {numThreads};
+
+public:
+
+    LinkedList_NBR(int numThreads) : numThreads{numThreads}
+    {
+        Node* sentinel = new Node(nullptr);
+        head.store(sentinel);
+        tail.store(sentinel);
+        head.load()->next.store(tail.load());
+    }
+
+    ~LinkedList_NBR()
+    {
+        Node* node = getUnmarked(head.load());
+        while(node != tail.load())
+        {
+            Node* next = getUnmarked(node->next.load());
+            delete node;
+            node = next;
+        }
+        delete tail.load();
+    }
+
+    bool add(T* item, int threadID)
+    {
+        Node *curr, *next, *predNode;
+        std::atomic<Node*> *pred;
+        Node* node = new Node(item);
+        nbrList.start_op(threadID);
+        while (true) {
+            sigsetjmp(nbrList.restartPoint(threadID), 0);
+            nbrList.beginReadPhase(threadID);
+            if (find(item, &pred, &predNode, &curr, &next, threadID)) 
+            {
+                nbrList.endReadPhase(threadID);
+                nbrList.end_op(threadID);
+                delete node;
+                return false;
+            }
+            nbrList.endReadPhase(threadID, predNode, getUnmarked(curr));
+            node->next.store(curr, std::memory_order_relaxed);
+            Node *temp = getUnmarked(curr);
+            if (pred->compare_exchange_strong(temp, node)) 
+            {
+                nbrList.end_op(threadID);
+                return true;
+            }
+        }
+    }
+
+    bool remove(T* item, int threadID)
+    {
+        Node *curr, *next, *predNode;
+        std::atomic<Node*> *pred;
+        nbrList.start_op(threadID);
+        while (true) 
+        {
+            sigsetjmp(nbrList.restartPoint(threadID), 0);
+            nbrList.beginReadPhase(threadID);
+            if (!find(item, &pred, &predNode, &curr, &next, threadID)) {
+                nbrList.endReadPhase(threadID);
+                nbrList.end_op(threadID);
+                return false;
+            }
+            nbrList.endReadPhase(threadID, predNode, getUnmarked(curr), getUnmarked(next));
+            Node *temp = getUnmarked(next);
+            if (!curr->next.compare_exchange_strong(temp, getMarked(next))) {
+                continue;
+            }
+            temp = getUnmarked(curr);
+            if (pred->compare_exchange_strong(temp, getUnmarked(next))) 
+            {
+                nbrList.retireNode(getUnmarked(curr), threadID);
+            }
+            nbrList.end_op(threadID);
+            return true;
+        }
+    }
+
+    bool contains (T* item, int threadID)
+    {
+        Node *curr, *next, *predNode;
+        std::atomic<Node*> *pred;
+        bool found;
+        nbrList.start_op(threadID);
+        sigsetjmp(nbrList.restartPoint(threadID), 0);
+        nbrList.beginReadPhase(threadID);
+        found = find(item, &pred, &predNode, &curr, &next, threadID);
+        nbrList.endReadPhase(threadID);
+        nbrList.end_op(threadID);
+        return found;
+    }
+
+    uint64_t getRetiredCountLinkedList(int threadID)
+    {
+        return nbrList.getRetiredNodeCount(threadID);
+    }
+
+
+private:
+
+    // Runs inside the caller's read phase and only loads, except when it has to
+    // unlink a marked node: it then reserves the three nodes involved, does the
+    // CAS in a short write phase and resumes reading from the reserved pred.
+    // predNode is the node owning pred, or nullptr when pred is the head.
+    bool find (T* item, std::atomic<Node*> **par_pred, Node **par_pred_node, Node **par_curr, Node **par_next, const int threadID)
+    {
+        std::atomic<Node*> *pred;
+        Node *curr, *next, *predNode;
+     try_again:
+        pred = &head;
+        predNode = nullptr;
+        next = nullptr;
+        curr = pred->load();
+        while (true) {
+            if (getUnmarked(curr) == nullptr) 
+            {
+                break;
+            }
+            next = curr->next.load();
+            if (getUnmarked(curr)->next.load() != next) 
+            {
+                goto try_again;
+            }
+            if (getUnmarked(next) == tail.load()) 
+            {
+                break;
+            }
+            if (pred->load() != getUnmarked(curr)) 
+            {
+                goto try_again;
+            }
+            if (getUnmarked(next) == next) 
+            {
+                if (getUnmarked(curr)->item != nullptr && !(*getUnmarked(curr)->item < *item)) 
+                {
+                    *par_curr = curr;
+                    *par_pred = pred;
+                    *par_pred_node = predNode;
+                    *par_next = next;
+                    return (*getUnmarked(curr)->item == *item);
+                }
+                pred = &getUnmarked(curr)->next;
+                predNode = getUnmarked(curr);
+            } 
+            else 
+            {
+                nbrList.endReadPhase(threadID, predNode, getUnmarked(curr), getUnmarked(next));
+                Node *temp = getUnmarked(curr);
+                bool unlinked = pred->compare_exchange_strong(temp, getUnmarked(next));
+                if (unlinked) 
+                {
+                    nbrList.retireNode(getUnmarked(curr), threadID);
+                }
+                nbrList.beginReadPhase(threadID);
+                if (!unlinked) 
+                {
+                    goto try_again;
+                }
+            }
+            curr = next;
+        }
+        *par_curr = curr;
+        *par_pred = pred;
+        *par_pred_node = predNode;
+        *par_next = next;
+        return false;
+    }
+};
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef NEUTRALIZATION_BASED_RECLAMATION_HPP
+#define NEUTRALIZATION_BASED_RECLAMATION_HPP
+
+#include <iostream>
+#include <atomic>
+#include <vector>
+#include <csignal>
+#include <csetjmp>
+#include <pthread.h>
+#include <thread>
+
+#define MAX_NUMBER_OF_THREADS_NBR 40
+#define NBR_MAX_RESERVATIONS 3
+#define NBR_RECLAIM_THRESHOLD 512
+#define NBR_SIGNAL SIGUSR1
+
+// The signal handler is shared by every NBR domain, so the per-thread restart
+// point it jumps to is reached through a thread local pointer. acknowledged is
+// the last neutralizeCount the thread has seen at a point where it held no
+// unreserved node, set by the handler and by beginReadPhase.
+struct NbrThreadState {
+    sigjmp_buf restartPoint;
+    volatile sig_atomic_t restartable;
+    std::atomic<uint64_t> neutralizeCount;
+    std::atomic<uint64_t> acknowledged;
+};
+
+static thread_local NbrThreadState* nbrCurrentThread = nullptr;
+
+static void nbrSignalHandler(int)
+{
+    NbrThreadState* state = nbrCurrentThread;
+    if(state == nullptr)
+    {
+        return;
+    }
+    state->acknowledged.store(state->neutralizeCount.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    if(state->restartable)
+    {
+        state->restartable = 0;
+        siglongjmp(state->restartPoint, 1);
+    }
+}
+
+// Operations are split into a read phase, which only loads shared memory and
+// can be abandoned at any point, and a write phase, which starts by reserving
+// the nodes it will touch. A reclaimer neutralizes every thread inside an
+// operation, waits until each has acknowledged, and then frees whatever is not
+// reserved.
+//
+// Usage inside an operation:
+//     sigsetjmp(domain.restartPoint(tid), 0);
+//     domain.beginReadPhase(tid);
+//     ... loads only, no allocation ...
+//     domain.endReadPhase(tid, a, b, c);
+//     ... CAS/stores on a, b, c and retireNode ...
+template<typename T>
+class NeutralizationBasedReclamation{
+
+private:
+    int numThreads;
+    NbrThreadState threadState[MAX_NUMBER_OF_THREADS_NBR];
+    pthread_t threadHandles[MAX_NUMBER_OF_THREADS_NBR];
+    std::atomic<bool> inOperation[MAX_NUMBER_OF_THREADS_NBR];
+    // Reclaimers about to signal the thread; end_op waits for them so the
+    // thread cannot exit while its handle is still in use
+    std::atomic<int> signalers[MAX_NUMBER_OF_THREADS_NBR];
+    uint64_t seenNeutralizeCount[MAX_NUMBER_OF_THREADS_NBR];
+    std::atomic<T*> reservations[MAX_NUMBER_OF_THREADS_NBR][NBR_MAX_RESERVATIONS];
+    std::vector<T*> retiredList[MAX_NUMBER_OF_THREADS_NBR];
+    uint64_t retiredNodesCount[MAX_NUMBER_OF_THREADS_NBR];
+
+public:
+    NeutralizationBasedReclamation(int threadCount)
+    {
+        numThreads = threadCount;
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_NBR; i++)
+        {
+            threadState[i].restartable = 0;
+            threadState[i].neutralizeCount.store(0, std::memory_order_relaxed);
+            threadState[i].acknowledged.store(0, std::memory_order_relaxed);
+            inOperation[i].store(false, std::memory_order_relaxed);
+            signalers[i].store(0, std::memory_order_relaxed);
+            seenNeutralizeCount[i] = 0;
+            retiredNodesCount[i] = 0;
+            retiredList[i].reserve(NBR_RECLAIM_THRESHOLD);
+            for(int j = 0; j < NBR_MAX_RESERVATIONS; j++)
+            {
+                reservations[i][j].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        struct sigaction act;
+        sigemptyset(&act.sa_mask);
+        act.sa_handler = nbrSignalHandler;
+        // SA_NODEFER keeps the signal unblocked after jumping out of the
+        // handler, so restart points need not save the signal mask.
+        act.sa_flags = SA_RESTART | SA_NODEFER;
+        sigaction(NBR_SIGNAL, &act, nullptr);
+    }
+
+    ~NeutralizationBasedReclamation()
+    {
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_NBR; i++)
+        {
+            for(auto node : retiredList[i])
+            {
+                delete node;
+            }
+        }
+    }
+
+    sigjmp_buf& restartPoint(int threadID)
+    {
+        return threadState[threadID].restartPoint;
+    }
+
+    void start_op(int threadID)
+    {
+        threadHandles[threadID] = pthread_self();
+        nbrCurrentThread = &threadState[threadID];
+        inOperation[threadID].store(true, std::memory_order_seq_cst);
+    }
+
+    void end_op(int threadID)
+    {
+        threadState[threadID].restartable = 0;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        for(int j = 0; j < NBR_MAX_RESERVATIONS; j++)
+        {
+            reservations[threadID][j].store(nullptr, std::memory_order_relaxed);
+        }
+        inOperation[threadID].store(false, std::memory_order_seq_cst);
+        while(signalers[threadID].load(std::memory_order_seq_cst) != 0) { } // spin
+    }
+
+    void beginReadPhase(int threadID)
+    {
+        seenNeutralizeCount[threadID] = threadState[threadID].neutralizeCount.load(std::memory_order_seq_cst);
+        threadState[threadID].acknowledged.store(seenNeutralizeCount[threadID], std::memory_order_seq_cst);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        threadState[threadID].restartable = 1;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    // Publishes the reservations and leaves the read phase. If a reclaimer
+    // neutralized this thread in the meantime (even if its signal has not been
+    // delivered yet) the nodes read may already be freed, so the operation
+    // jumps back to its restart point instead of returning.
+    void endReadPhase(int threadID, T* r0 = nullptr, T* r1 = nullptr, T* r2 = nullptr)
+    {
+        reservations[threadID][0].store(r0, std::memory_order_seq_cst);
+        reservations[threadID][1].store(r1, std::memory_order_seq_cst);
+        reservations[threadID][2].store(r2, std::memory_order_seq_cst);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        threadState[threadID].restartable = 0;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        if(threadState[threadID].neutralizeCount.load(std::memory_order_seq_cst) != seenNeutralizeCount[threadID])
+        {
+            siglongjmp(threadState[threadID].restartPoint, 1);
+        }
+    }
+
+    void retireNode(T* obj, int threadID)
+    {
+        if(obj == nullptr)
+        {
+            return;
+        }
+        retiredList[threadID].push_back(obj);
+        retiredNodesCount[threadID] += 1;
+        if(retiredList[threadID].size() >= NBR_RECLAIM_THRESHOLD)
+        {
+            reclaim(threadID);
+        }
+    }
+
+    uint64_t getRetiredNodeCount(int threadID)
+    {
+        return retiredNodesCount[threadID];
+    }
+
+private:
+    bool isReserved(T* obj)
+    {
+        for(int i = 0; i < numThreads; i++)
+        {
+            for(int j = 0; j < NBR_MAX_RESERVATIONS; j++)
+            {
+                if(reservations[i][j].load(std::memory_order_seq_cst) == obj)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Neutralizes the threads that are inside an operation and waits until
+    // each has run the handler, started a new read phase or left its
+    // operation. After that no thread holds a node it has not reserved, so
+    // every retired node without a reservation can be freed. The handler runs
+    // even in a write phase, so two reclaimers waiting on each other still
+    // acknowledge.
+    void reclaim(int threadID)
+    {
+        uint64_t waitFor[MAX_NUMBER_OF_THREADS_NBR];
+        for(int i = 0; i < numThreads; i++)
+        {
+            waitFor[i] = 0;
+            if(i == threadID)
+            {
+                continue;
+            }
+            signalers[i].fetch_add(1, std::memory_order_seq_cst);
+            if(inOperation[i].load(std::memory_order_seq_cst))
+            {
+                waitFor[i] = threadState[i].neutralizeCount.fetch_add(1, std::memory_order_seq_cst) + 1;
+                pthread_kill(threadHandles[i], NBR_SIGNAL);
+            }
+            signalers[i].fetch_sub(1, std::memory_order_seq_cst);
+        }
+        for(int i = 0; i < numThreads; i++)
+        {
+            while(waitFor[i] != 0 && inOperation[i].load(std::memory_order_seq_cst) &&
+                  threadState[i].acknowledged.load(std::memory_order_seq_cst) < waitFor[i])
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        std::vector<T*> survivors;
+        for(auto node : retiredList[threadID])
+        {
+            if(isReserved(node))
+            {
+                survivors.push_back(node);
+                continue;
+            }
+            delete node;
+            retiredNodesCount[threadID] -= 1;
+        }
+        retiredList[threadID].swap(survivors);
+    }
+};
+#endif
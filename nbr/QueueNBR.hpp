@@ -0,0 +1,198 @@
+#ifndef QUEUE_NBR_HPP
+#define QUEUE_NBR_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "NeutralizationBasedReclamation.hpp"
+
+template<typename T>
+class Queue_NBR
+{
+
+private:
+    struct Node{
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* item) 
+        {
+            this->item = item;
+            this->next.store(nullptr);
+        }
+
+        bool casNext(Node *cmp, Node *val) {
+            return next.compare_exchange_strong(cmp, val);
+        }
+    };
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    const int numOfThreads;
+    NeutralizationBasedReclamation<Node> nbrQueue{numOfThreads};
+
+public:
+
+    Queue_NBR(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = new Node(nullptr);
+        head.store(sentinel, std::memory_order_relaxed);
+        tail.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~Queue_NBR(){
+        while(dequeue(0) != nullptr);
+        delete head.load();
+    }
+
+    bool enqueue(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = new Node(item);
+        nbrQueue.start_op(threadID);
+        while(true)
+        {
+            sigsetjmp(nbrQueue.restartPoint(threadID), 0);
+            nbrQueue.beginReadPhase(threadID);
+            Node* temp = tail.load();
+            Node* next  = temp->next.load();
+            if (temp != tail.load()) 
+            {
+                continue;
+            }
+            nbrQueue.endReadPhase(threadID, temp, next);
+            if (next == nullptr) 
+            {
+                if (temp->casNext(nullptr, node)) 
+                {
+                    tail.compare_exchange_strong(temp, node);
+                    nbrQueue.end_op(threadID);
+                    return true;
+                }
+            } 
+            else 
+            {
+                tail.compare_exchange_strong(temp, next);
+            }
+        }
+    }
+
+    T* dequeue(int threadID)
+    {
+        nbrQueue.start_op(threadID);
+        while(true)
+        {
+            sigsetjmp(nbrQueue.restartPoint(threadID), 0);
+            nbrQueue.beginReadPhase(threadID);
+            Node* node = head.load();
+            if (node == tail.load()) 
+            {
+                nbrQueue.end_op(threadID);
+                return nullptr;
+            }
+            Node* next = node->next.load();
+            nbrQueue.endReadPhase(threadID, node, next);
+            if (head.compare_exchange_strong(node, next)) 
+            {
+                T* item = next->item;
+                nbrQueue.retireNode(node, threadID);
+                nbrQueue.end_op(threadID);
+                return item;
+            }
+        }
+    }
+
+    // Links the items into a private chain, appends it with one CAS on the
+    // last node's next and then swings tail to the end of the chain. Null
+    // items are skipped.
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last, int threadID)
+    {
+        Node* chainFirst = nullptr;
+        Node* chainLast = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = new Node(*first);
+            if(chainLast == nullptr)
+            {
+                chainFirst = node;
+            }
+            else
+            {
+                chainLast->next.store(node, std::memory_order_relaxed);
+            }
+            chainLast = node;
+        }
+        if(chainFirst == nullptr)
+        {
+            return false;
+        }
+        nbrQueue.start_op(threadID);
+        while(true)
+        {
+            sigsetjmp(nbrQueue.restartPoint(threadID), 0);
+            nbrQueue.beginReadPhase(threadID);
+            Node* temp = tail.load();
+            Node* next  = temp->next.load();
+            if (temp != tail.load()) 
+            {
+                continue;
+            }
+            nbrQueue.endReadPhase(threadID, temp, next);
+            if (next == nullptr) 
+            {
+                if (temp->casNext(nullptr, chainFirst)) 
+                {
+                    tail.compare_exchange_strong(temp, chainLast);
+                    nbrQueue.end_op(threadID);
+                    return true;
+                }
+            } 
+            else 
+            {
+                tail.compare_exchange_strong(temp, next);
+            }
+        }
+    }
+
+    // One dequeue per item: a walk would have to reserve every node it
+    // passes before leaving the read phase, and there are only a few
+    // reservations
+    int dequeueBatch(int n, T** out, int threadID)
+    {
+        int count = 0;
+        while(count < n)
+        {
+            T* item = dequeue(threadID);
+            if(item == nullptr)
+            {
+                break;
+            }
+            out[count++] = item;
+        }
+        return count;
+    }
+
+    std::vector<T*> drain(int threadID)
+    {
+        std::vector<T*> items;
+        while(T* item = dequeue(threadID))
+        {
+            items.push_back(item);
+        }
+        return items;
+    }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return nbrQueue.getRetiredNodeCount(threadID);
+    }
+};
+
+#endif
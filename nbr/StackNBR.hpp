@@ -0,0 +1,175 @@
+#ifndef STACK_NBR_HPP
+#define STACK_NBR_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "NeutralizationBasedReclamation.hpp"
+
+template<typename T>
+class Stack_NBR {
+private:
+    struct Node {
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* item)
+        {
+            this->item = item;
+            this->next.store(nullptr);
+        }
+    };
+
+    std::atomic<Node*> top;
+    const int numOfThreads;
+    NeutralizationBasedReclamation<Node> nbrStack{numOfThreads};
+
+public:
+
+    Stack_NBR(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = new Node(nullptr);
+        top.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~Stack_NBR(){
+        while(pop(0) != nullptr);
+        delete top.load();
+    }
+
+    bool push(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = new Node(item);
+        nbrStack.start_op(threadID);
+        while(true)
+        {
+            sigsetjmp(nbrStack.restartPoint(threadID), 0);
+            nbrStack.beginReadPhase(threadID);
+            Node* temp = top.load();
+            nbrStack.endReadPhase(threadID);
+            node->next.store(temp, std::memory_order_relaxed);
+            if(top.compare_exchange_strong(temp,node))
+            {
+                nbrStack.end_op(threadID);
+                return true;
+            }
+        }   
+    }
+
+    T* pop(int threadID)
+    {
+        Node *temp, *next;
+        T* ret_data;
+        nbrStack.start_op(threadID);
+        while(true)
+        {
+            sigsetjmp(nbrStack.restartPoint(threadID), 0);
+            nbrStack.beginReadPhase(threadID);
+            temp = top.load();
+            if(temp == nullptr)
+            {
+                nbrStack.end_op(threadID);
+                return nullptr;
+            }
+            next = temp->next.load();
+            nbrStack.endReadPhase(threadID, temp);
+            if(top.compare_exchange_strong(temp, next))
+            {
+                ret_data = temp->item;
+                nbrStack.retireNode(temp,threadID);
+                nbrStack.end_op(threadID);
+                return ret_data;
+            }
+        }
+    }
+
+    // Links the items into a private chain and splices it onto top with one
+    // CAS, so the last item ends up on top. Null items are skipped.
+    template<typename Iterator>
+    bool pushBatch(Iterator first, Iterator last, int threadID)
+    {
+        Node* bottom = nullptr;
+        Node* chain = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = new Node(*first);
+            node->next.store(chain, std::memory_order_relaxed);
+            if(bottom == nullptr)
+            {
+                bottom = node;
+            }
+            chain = node;
+        }
+        if(chain == nullptr)
+        {
+            return false;
+        }
+        nbrStack.start_op(threadID);
+        while(true)
+        {
+            sigsetjmp(nbrStack.restartPoint(threadID), 0);
+            nbrStack.beginReadPhase(threadID);
+            Node* temp = top.load();
+            nbrStack.endReadPhase(threadID);
+            bottom->next.store(temp, std::memory_order_relaxed);
+            if(top.compare_exchange_strong(temp,chain))
+            {
+                nbrStack.end_op(threadID);
+                return true;
+            }
+        }
+    }
+
+    // One pop per item: a neutralized thread restarts at the sigsetjmp of the
+    // operation it was in, so each pop keeps its own operation
+    int popBatch(int n, T** out, int threadID)
+    {
+        int count = 0;
+        while(count < n)
+        {
+            T* item = pop(threadID);
+            if(item == nullptr)
+            {
+                break;
+            }
+            out[count++] = item;
+        }
+        return count;
+    }
+
+    // Takes the whole stack with one exchange. The detached chain is private,
+    // so walking it needs no read phase; it is retired node by node. Items
+    // come out in pop order.
+    std::vector<T*> popAll(int threadID)
+    {
+        std::vector<T*> items;
+        nbrStack.start_op(threadID);
+        Node* node = top.exchange(nullptr);
+        while(node != nullptr)
+        {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            if(node->item != nullptr)
+            {
+                items.push_back(node->item);
+            }
+            nbrStack.retireNode(node,threadID);
+            node = next;
+        }
+        nbrStack.end_op(threadID);
+        return items;
+    }
+
+    uint64_t getRetiredCountStack(int threadID)
+    {
+        return nbrStack.getRetiredNodeCount(threadID);
+    }
+};
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef LINKED_LIST_PerCpu_HPP
+#define LINKED_LIST_PerCpu_HPP
+
+#include <atomic>
+#include <iostream>
+#include "PerCpuReclamation.hpp"
+
+template<typename T>
+class LinkedList_PerCpu {
+
+private:
+    struct Node {
+        T* item;
+        std::atomic<Node*> next;
+        Node* retireNext;
+        uint64_t retire_epoch;
+
+        Node(T* item) 
+        { 
+            this->item = item;
+            this->next.store(nullptr);
+            this->retireNext = nullptr;
+            this->retire_epoch = 0;
+        }
+    };
+
+    bool isMarked(Node * node) {
+    	return ((size_t) node & 0x1);
+    }
+
+    Node * getMarked(Node * node) {
+    	return (Node*)((size_t) node | 0x1);
+    }
+
+    Node * getUnmarked(Node * node) {
+    	return (Node*)((size_t) node & (~0x1));
+    }
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    int numThreads;
+    PerCpuReclamation<Node> pcList;
+
+public:
+
+    LinkedList_PerCpu(int numThreads) : numThreads{numThreads}
+    {
+        Node* sentinel = new Node(nullptr);
+        head.store(sentinel);
+        tail.store(sentinel);
+        head.load()->next.store(tail.load());
+    }
+
+    ~LinkedList_PerCpu()
+    {
+        Node* node = getUnmarked(head.load());
+        while(node != tail.load())
+        {
+            Node* next = getUnmarked(node->next.load());
+            delete node;
+            node = next;
+        }
+        delete tail.load();
+    }
+
+    bool add(T* item, int)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        Node* node = new Node(item);
+        int parity = pcList.start_op();
+        while (true) {
+            if (find(item, &pred, &curr, &next)) 
+            {
+                delete node;
+                pcList.end_op(parity);
+                return false;
+            }
+            node->next.store(curr, std::memory_order_relaxed);
+            Node *temp = getUnmarked(curr);
+            if (pred->compare_exchange_strong(temp, node)) 
+            {
+                pcList.end_op(parity);
+                return true;
+            }
+        }
+    }
+
+    bool remove(T* item, int)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        int parity = pcList.start_op();
+        while (true) 
+        {
+            if (!find(item, &pred, &curr, &next)) {
+                pcList.end_op(parity);
+                return false;
+            }
+            Node *temp = getUnmarked(next);
+            if (!curr->next.compare_exchange_strong(temp, getMarked(next))) {
+                continue;
+            }
+            temp = getUnmarked(curr);
+            if (pred->compare_exchange_strong(temp, getUnmarked(next))) 
+            {
+                pcList.retireNode(getUnmarked(curr));
+            }
+            pcList.end_op(parity);
+            return true;
+        }
+    }
+
+    bool contains (T* item, int)
+    {
+        Node *curr, *next;
+        std::atomic<Node*> *pred;
+        int parity = pcList.start_op();
+        bool found = find(item, &pred, &curr, &next);
+        pcList.end_op(parity);
+        return found;
+    }
+
+    // The domain counts per CPU, so the whole total is reported on thread 0
+    uint64_t getRetiredCountLinkedList(int threadID)
+    {
+        return (threadID == 0) ? pcList.getRetiredNodeCount() : 0;
+    }
+
+
+private:
+
+    // Callers hold the thread's epoch reservation for the whole operation, so
+    // the traversal itself publishes nothing.
+    bool find (T* item, std::atomic<Node*> **par_pred, Node **par_curr, Node **par_next)
+    {
+        std::atomic<Node*> *pred;
+        Node *curr, *next;
+     try_again:
+        pred = &head;
+        curr = pred->load();
+        while (true) {
+            if (getUnmarked(curr) == nullptr) 
+            {
+                break;
+            }
+            next = curr->next.load();
+            if (getUnmarked(curr)->next.load() != next) 
+            {
+                goto try_again;
+            }
+            if (getUnmarked(next) == tail.load()) 
+            {
+                break;
+            }
+            if (pred->load() != getUnmarked(curr)) 
+            {
+                goto try_again;
+            }
+            if (getUnmarked(next) == next) 
+            {
+                if (getUnmarked(curr)->item != nullptr && !(*getUnmarked(curr)->item < *item)) 
+                {
+                    *par_curr = curr;
+                    *par_pred = pred;
+                    *par_next = next;
+                    return (*getUnmarked(curr)->item == *item);
+                }
+                pred = &getUnmarked(curr)->next;
+            } 
+            else 
+            {
+                Node *temp = getUnmarked(curr);
+                if (!pred->compare_exchange_strong(temp, getUnmarked(next))) 
+                {
+                    goto try_again;
+                }
+                pcList.retireNode(getUnmarked(curr));
+            }
+            curr = next;
+        }
+        *par_curr = curr;
+        *par_pred = pred;
+        *par_next = next;
+        return false;
+    }
+};
+
+#endif
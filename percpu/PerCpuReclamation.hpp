@@ -0,0 +1,191 @@
+#ifndef PER_CPU_RECLAMATION_HPP
+#define PER_CPU_RECLAMATION_HPP
+
+#include <iostream>
+#include <atomic>
+#include <sched.h>
+#include <unistd.h>
+
+#define PERCPU_RECLAIM_FREQUENCY 64
+#define PERCPU_GRACE_EPOCHS 3
+
+// Epoch-based reclamation whose state is indexed by CPU instead of thread.
+// Each CPU keeps, per epoch parity, how many operations entered and how many
+// left on it; an operation may end on a different CPU than it started, only
+// the sums over all CPUs have to balance. Advancing the epoch needs the
+// parity of the previous epoch to balance, so scans cost O(CPUs) whatever
+// the number of threads, and threads need no registration or ID.
+//
+// Retired nodes go to a lock-free list on the retiring CPU and are freed
+// PERCPU_GRACE_EPOCHS epochs later: two advances to drain both parities,
+// plus one because the balance check of the first may predate the retire.
+// Nodes need a `T* retireNext` and a `uint64_t retire_epoch` field.
+template<typename T>
+class PerCpuReclamation{
+
+private:
+    struct alignas(64) CpuState {
+        std::atomic<uint64_t> lockCount[2];
+        std::atomic<uint64_t> unlockCount[2];
+        std::atomic<T*> retiredHead;
+        std::atomic<uint64_t> retiredCount;
+        std::atomic<uint64_t> retireStat;
+    };
+
+    alignas(64) std::atomic<uint64_t> globalEpoch{0};
+    int numCpus;
+    CpuState* cpus;
+
+    // sched_getcpu reads the CPU id the kernel keeps in the thread's rseq
+    // area when glibc has registered one, so this is not a system call
+    CpuState& currentCpu()
+    {
+        int cpu = sched_getcpu();
+        if(cpu < 0)
+        {
+            cpu = 0;
+        }
+        return cpus[cpu % numCpus];
+    }
+
+    void tryAdvance()
+    {
+        uint64_t e = globalEpoch.load(std::memory_order_seq_cst);
+        int parity = (e + 1) & 1;
+        uint64_t unlocks = 0;
+        uint64_t locks = 0;
+        // Unlocks first: a counted exit implies its entry is counted below
+        for(int i = 0; i < numCpus; i++)
+        {
+            unlocks += cpus[i].unlockCount[parity].load(std::memory_order_seq_cst);
+        }
+        for(int i = 0; i < numCpus; i++)
+        {
+            locks += cpus[i].lockCount[parity].load(std::memory_order_seq_cst);
+        }
+        if(locks == unlocks)
+        {
+            globalEpoch.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+        }
+    }
+
+    void pushRetired(CpuState& cpu, T* first, T* last)
+    {
+        T* head = cpu.retiredHead.load(std::memory_order_relaxed);
+        do
+        {
+            last->retireNext = head;
+        } while(!cpu.retiredHead.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void reclaim(CpuState& cpu)
+    {
+        T* node = cpu.retiredHead.exchange(nullptr, std::memory_order_acquire);
+        uint64_t e = globalEpoch.load(std::memory_order_seq_cst);
+        T* keepFirst = nullptr;
+        T* keepLast = nullptr;
+        uint64_t freed = 0;
+        while(node != nullptr)
+        {
+            T* next = node->retireNext;
+            if(node->retire_epoch + PERCPU_GRACE_EPOCHS <= e)
+            {
+                delete node;
+                freed++;
+            }
+            else
+            {
+                node->retireNext = keepFirst;
+                keepFirst = node;
+                if(keepLast == nullptr)
+                {
+                    keepLast = node;
+                }
+            }
+            node = next;
+        }
+        if(keepFirst != nullptr)
+        {
+            pushRetired(cpu, keepFirst, keepLast);
+        }
+        cpu.retiredCount.fetch_sub(freed, std::memory_order_relaxed);
+    }
+
+public:
+    PerCpuReclamation()
+    {
+        numCpus = sysconf(_SC_NPROCESSORS_CONF);
+        if(numCpus < 1)
+        {
+            numCpus = 1;
+        }
+        cpus = new CpuState[numCpus];
+        for(int i = 0; i < numCpus; i++)
+        {
+            for(int p = 0; p < 2; p++)
+            {
+                cpus[i].lockCount[p].store(0, std::memory_order_relaxed);
+                cpus[i].unlockCount[p].store(0, std::memory_order_relaxed);
+            }
+            cpus[i].retiredHead.store(nullptr, std::memory_order_relaxed);
+            cpus[i].retiredCount.store(0, std::memory_order_relaxed);
+            cpus[i].retireStat.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~PerCpuReclamation()
+    {
+        for(int i = 0; i < numCpus; i++)
+        {
+            T* node = cpus[i].retiredHead.load();
+            while(node != nullptr)
+            {
+                T* next = node->retireNext;
+                delete node;
+                node = next;
+            }
+        }
+        delete[] cpus;
+    }
+
+    // Returns the parity the operation entered with; pass it to end_op
+    int start_op()
+    {
+        int parity = globalEpoch.load(std::memory_order_seq_cst) & 1;
+        currentCpu().lockCount[parity].fetch_add(1, std::memory_order_seq_cst);
+        return parity;
+    }
+
+    void end_op(int parity)
+    {
+        currentCpu().unlockCount[parity].fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    void retireNode(T* obj)
+    {
+        if(obj == nullptr)
+        {
+            return;
+        }
+        obj->retire_epoch = globalEpoch.load(std::memory_order_seq_cst);
+        CpuState& cpu = currentCpu();
+        pushRetired(cpu, obj, obj);
+        cpu.retiredCount.fetch_add(1, std::memory_order_relaxed);
+        if(cpu.retireStat.fetch_add(1, std::memory_order_relaxed) % PERCPU_RECLAIM_FREQUENCY == 0)
+        {
+            tryAdvance();
+            reclaim(cpu);
+        }
+    }
+
+    uint64_t getRetiredNodeCount()
+    {
+        uint64_t count = 0;
+        for(int i = 0; i < numCpus; i++)
+        {
+            count += cpus[i].retiredCount.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+};
+#endif
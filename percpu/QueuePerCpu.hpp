@@ -0,0 +1,223 @@
+#ifndef QUEUE_PerCpu_HPP
+#define QUEUE_PerCpu_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include <climits>
+#include "PerCpuReclamation.hpp"
+
+template<typename T>
+class Queue_PerCpu
+{
+
+private:
+    struct Node{
+        T* item;
+        std::atomic<Node*> next;
+        Node* retireNext;
+        uint64_t retire_epoch;
+
+        Node(T* item) 
+        {
+            this->item = item;
+            this->next.store(nullptr);
+            this->retireNext = nullptr;
+            this->retire_epoch = 0;
+        }
+
+        bool casNext(Node *cmp, Node *val) {
+            return next.compare_exchange_strong(cmp, val);
+        }
+    };
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+    const int numOfThreads;
+    PerCpuReclamation<Node> pcQueue;
+
+public:
+
+    Queue_PerCpu(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = new Node(nullptr);
+        head.store(sentinel, std::memory_order_relaxed);
+        tail.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~Queue_PerCpu(){
+        while(dequeue(0) != nullptr);
+        delete head.load();
+    }
+
+    bool enqueue(T* item, int)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = new Node(item);
+        int parity = pcQueue.start_op();
+        while(true)
+        {
+            Node* temp = tail.load();
+            Node* next  = temp->next.load();
+            if (temp == tail.load()) 
+            {
+                if (next == nullptr) 
+                {
+                    if (temp->casNext(nullptr, node)) 
+                    {
+                        tail.compare_exchange_strong(temp, node);
+                        pcQueue.end_op(parity);
+                        return true;
+                    }
+                } 
+                else 
+                {
+                    tail.compare_exchange_strong(temp, next);
+                }
+            }
+        }
+    }
+
+    T* dequeue(int)
+    {
+        int parity = pcQueue.start_op();
+        Node* node = head.load();
+        while (node != tail.load()) 
+        {
+            Node* next = node->next.load();
+            if (head.compare_exchange_strong(node, next)) 
+            {
+                T* item = next->item;
+                pcQueue.retireNode(node);
+                pcQueue.end_op(parity);
+                return item;
+            }
+            node = head.load();
+        }
+        pcQueue.end_op(parity);
+        return nullptr;
+    }
+
+    // The domain counts per CPU, so the whole total is reported on thread 0
+    // Links the items into a private chain, appends it with one CAS on the
+    // last node's next and then swings tail to the end of the chain. Null
+    // items are skipped.
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last, int)
+    {
+        Node* chainFirst = nullptr;
+        Node* chainLast = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = new Node(*first);
+            if(chainLast == nullptr)
+            {
+                chainFirst = node;
+            }
+            else
+            {
+                chainLast->next.store(node, std::memory_order_relaxed);
+            }
+            chainLast = node;
+        }
+        if(chainFirst == nullptr)
+        {
+            return false;
+        }
+        int parity = pcQueue.start_op();
+        while(true)
+        {
+            Node* temp = tail.load();
+            Node* next  = temp->next.load();
+            if (temp == tail.load()) 
+            {
+                if (next == nullptr) 
+                {
+                    if (temp->casNext(nullptr, chainFirst)) 
+                    {
+                        tail.compare_exchange_strong(temp, chainLast);
+                        pcQueue.end_op(parity);
+                        return true;
+                    }
+                } 
+                else 
+                {
+                    tail.compare_exchange_strong(temp, next);
+                }
+            }
+        }
+    }
+
+    int dequeueBatch(int n, T** out, int)
+    {
+        std::vector<T*> items;
+        dequeueChain(n, items);
+        for(size_t i = 0; i < items.size(); i++)
+        {
+            out[i] = items[i];
+        }
+        return (int)items.size();
+    }
+
+    // Everything up to the tail seen while walking, with one CAS on head
+    std::vector<T*> drain(int)
+    {
+        std::vector<T*> items;
+        dequeueChain(INT_MAX, items);
+        return items;
+    }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return (threadID == 0) ? pcQueue.getRetiredNodeCount() : 0;
+    }
+
+private:
+    // Walks up to n nodes past head, never past tail, and moves head to the
+    // last of them with one CAS. Nothing reachable from head is freed before the operation ends and next links never change once set,
+    // so while head is still node the walked chain is exactly what the CAS
+    // detaches.
+    void dequeueChain(int n, std::vector<T*>& items)
+    {
+        int parity = pcQueue.start_op();
+        while(true)
+        {
+            items.clear();
+            Node* node = head.load();
+            Node* last = node;
+            while((int)items.size() < n && last != tail.load())
+            {
+                Node* next = last->next.load();
+                if(next == nullptr)
+                {
+                    break;
+                }
+                items.push_back(next->item);
+                last = next;
+            }
+            if(last == node)
+            {
+                break;
+            }
+            if(head.compare_exchange_strong(node, last))
+            {
+                while(node != last)
+                {
+                    Node* next = node->next.load(std::memory_order_relaxed);
+                    pcQueue.retireNode(node);
+                    node = next;
+                }
+                break;
+            }
+        }
+        pcQueue.end_op(parity);
+    }
+};
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef STACK_PerCpu_HPP
+#define STACK_PerCpu_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "PerCpuReclamation.hpp"
+
+template<typename T>
+class Stack_PerCpu {
+private:
+    struct Node {
+        T* item;
+        std::atomic<Node*> next;
+        Node* retireNext;
+        uint64_t retire_epoch;
+
+        Node(T* item)
+        {
+            this->item = item;
+            this->next.store(nullptr);
+            this->retireNext = nullptr;
+            this->retire_epoch = 0;
+        }
+    };
+
+    std::atomic<Node*> top;
+    const int numOfThreads;
+    PerCpuReclamation<Node> pcStack;
+
+public:
+
+    Stack_PerCpu(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = new Node(nullptr);
+        top.store(sentinel, std::memory_order_relaxed);
+    }
+
+    ~Stack_PerCpu(){
+        while(pop(0) != nullptr);
+        delete top.load();
+    }
+
+    bool push(T* item, int)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = new Node(item);
+        int parity = pcStack.start_op();
+        while(true)
+        {
+            Node* temp = top.load();
+            node->next.store(temp, std::memory_order_relaxed);
+            if(top.compare_exchange_strong(temp,node))
+            {
+                pcStack.end_op(parity);
+                return true;
+            }
+        }   
+    }
+
+    T* pop(int)
+    {
+        Node *temp, *next;
+        T* ret_data;
+        int parity = pcStack.start_op();
+        while(true)
+        {
+            temp = top.load();
+            if(temp == nullptr)
+            {
+                pcStack.end_op(parity);
+                return nullptr;
+            }
+            next = temp->next.load();
+            if(top.compare_exchange_strong(temp, next))
+            {
+                ret_data = temp->item;
+                pcStack.retireNode(temp);
+                pcStack.end_op(parity);
+                return ret_data;
+            }
+        }
+    }
+
+    // Links the items into a private chain and splices it onto top with one
+    // CAS, so the last item ends up on top. Null items are skipped.
+    template<typename Iterator>
+    bool pushBatch(Iterator first, Iterator last, int)
+    {
+        Node* bottom = nullptr;
+        Node* chain = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = new Node(*first);
+            node->next.store(chain, std::memory_order_relaxed);
+            if(bottom == nullptr)
+            {
+                bottom = node;
+            }
+            chain = node;
+        }
+        if(chain == nullptr)
+        {
+            return false;
+        }
+        int parity = pcStack.start_op();
+        while(true)
+        {
+            Node* temp = top.load();
+            bottom->next.store(temp, std::memory_order_relaxed);
+            if(top.compare_exchange_strong(temp,chain))
+            {
+                pcStack.end_op(parity);
+                return true;
+            }
+        }
+    }
+
+    // Detaches up to n nodes with one CAS. Nothing reachable from top is
+    // freed before the operation ends, and top only changes by CAS, so while
+    // top is still first the chain below it is unchanged. Stops, like pop,
+    // at the sentinel.
+    int popBatch(int n, T** out, int)
+    {
+        Node *first, *last;
+        int parity = pcStack.start_op();
+        while(true)
+        {
+            first = top.load();
+            if(first == nullptr || n <= 0)
+            {
+                pcStack.end_op(parity);
+                return 0;
+            }
+            last = first;
+            for(int taken = 1; taken < n && last->item != nullptr; taken++)
+            {
+                Node* next = last->next.load();
+                if(next == nullptr)
+                {
+                    break;
+                }
+                last = next;
+            }
+            if(top.compare_exchange_strong(first, last->next.load()))
+            {
+                break;
+            }
+        }
+        int count = 0;
+        Node* node = first;
+        while(true)
+        {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            if(node->item != nullptr)
+            {
+                out[count++] = node->item;
+            }
+            pcStack.retireNode(node);
+            if(node == last)
+            {
+                break;
+            }
+            node = next;
+        }
+        pcStack.end_op(parity);
+        return count;
+    }
+
+    // Takes the whole stack with one exchange; the detached chain is private
+    // and is retired node by node. Items come out in pop order.
+    std::vector<T*> popAll(int)
+    {
+        std::vector<T*> items;
+        int parity = pcStack.start_op();
+        Node* node = top.exchange(nullptr);
+        while(node != nullptr)
+        {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            if(node->item != nullptr)
+            {
+                items.push_back(node->item);
+            }
+            pcStack.retireNode(node);
+            node = next;
+        }
+        pcStack.end_op(parity);
+        return items;
+    }
+
+    // The domain counts per CPU, so the whole total is reported on thread 0
+    uint64_t getRetiredCountStack(int threadID)
+    {
+        return (threadID == 0) ? pcStack.getRetiredNodeCount() : 0;
+    }
+};
+
+#endif
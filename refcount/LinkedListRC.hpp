@@ -0,0 +1,208 @@
+#ifndef LINKED_LIST_RC_HPP
+#define LINKED_LIST_RC_HPP
+
+#include <atomic>
+#include <iostream>
+#include "ReferenceCounting.hpp"
+
+template<typename T>
+class LinkedList_RC {
+
+private:
+    struct Node {
+        T* item;
+        std::atomic<int64_t> refs;
+        bool retired;
+        CountedLink<Node> next;
+
+        Node(T* item) 
+        { 
+            this->item = item;
+            this->refs.store(1);
+            this->retired = false;
+        }
+    };
+
+    bool isMarked(Node * node) {
+    	return ((size_t) node & 0x1);
+    }
+
+    Node * getMarked(Node * node) {
+    	return (Node*)((size_t) node | 0x1);
+    }
+
+    Node * getUnmarked(Node * node) {
+    	return (Node*)((size_t) node & (~0x1));
+    }
+
+    CountedLink<Node> head;
+    Node* tail;
+    ReferenceCounting<Node> rcList;
+
+public:
+
+    LinkedList_RC() 
+    {
+        // The sentinel's link to itself is not counted
+        tail = new Node(nullptr);
+        tail->next.init(tail);
+        head.init(tail);
+    }
+
+    // The benchmark harness constructs every container with a thread count
+    LinkedList_RC(int) : LinkedList_RC() { }
+
+    ~LinkedList_RC()
+    {
+        rcList.compareExchange(head, head.load(), nullptr);
+    }
+
+    bool add(T* item)
+    {
+        Node *predNode, *curr, *next;
+        CountedLink<Node> *pred;
+        Node* node = new Node(item);
+        while (true) {
+            if (find(item, &pred, &predNode, &curr, &next)) 
+            {
+                releaseAll(predNode, curr, next);
+                delete node;
+                return false;
+            }
+            node->next.init(rcList.retain(getUnmarked(curr)));
+            bool added = rcList.compareExchange(*pred, getUnmarked(curr), node);
+            releaseAll(predNode, curr, next);
+            if (added) 
+            {
+                rcList.release(node);
+                return true;
+            }
+            rcList.release(node->next.load());
+        }
+    }
+
+    bool remove(T* item)
+    {
+        Node *predNode, *curr, *next;
+        CountedLink<Node> *pred;
+        while (true) 
+        {
+            if (!find(item, &pred, &predNode, &curr, &next)) {
+                releaseAll(predNode, curr, next);
+                return false;
+            }
+            if (!rcList.compareExchange(getUnmarked(curr)->next, getUnmarked(next), getMarked(next))) {
+                releaseAll(predNode, curr, next);
+                continue;
+            }
+            if (rcList.compareExchange(*pred, getUnmarked(curr), getUnmarked(next))) 
+            {
+                rcList.retireNode(curr);
+            }
+            releaseAll(predNode, curr, next);
+            return true;
+        }
+    }
+
+    bool contains (T* item)
+    {
+        Node *predNode, *curr, *next;
+        CountedLink<Node> *pred;
+        bool found = find(item, &pred, &predNode, &curr, &next);
+        releaseAll(predNode, curr, next);
+        return found;
+    }
+
+    bool add(T* item, int)
+    {
+        return add(item);
+    }
+
+    bool remove(T* item, int)
+    {
+        return remove(item);
+    }
+
+    bool contains(T* item, int)
+    {
+        return contains(item);
+    }
+
+    // Nodes are not owned by threads, so the whole count is reported on thread 0
+    uint64_t getRetiredCountLinkedList(int threadID)
+    {
+        return threadID == 0 ? rcList.getRetiredNodeCount() : 0;
+    }
+
+
+private:
+
+    void releaseAll(Node* predNode, Node* curr, Node* next)
+    {
+        rcList.release(predNode);
+        rcList.release(curr);
+        rcList.release(next);
+    }
+
+    // Hand-over-hand: a reference is held on pred's node (none for the head),
+    // curr and next, and all three are handed to the caller, who releases them.
+    // Releases are deferred, so walking the same prefix again is mostly free.
+    bool find (T* item, CountedLink<Node> **par_pred, Node **par_pred_node, Node **par_curr, Node **par_next)
+    {
+        CountedLink<Node> *pred;
+        Node *predNode, *curr, *next;
+     try_again:
+        pred = &head;
+        predNode = nullptr;
+        curr = rcList.acquire(head);
+        next = nullptr;
+        while (true) {
+            if (getUnmarked(curr) == nullptr) 
+            {
+                break;
+            }
+            next = rcList.acquire(getUnmarked(curr)->next);
+            if (getUnmarked(next) == tail) 
+            {
+                break;
+            }
+            if (pred->load() != getUnmarked(curr)) 
+            {
+                releaseAll(predNode, curr, next);
+                goto try_again;
+            }
+            if (getUnmarked(next) == next) 
+            {
+                if (getUnmarked(curr)->item != nullptr && !(*getUnmarked(curr)->item < *item)) 
+                {
+                    *par_curr = curr;
+                    *par_pred = pred;
+                    *par_pred_node = predNode;
+                    *par_next = next;
+                    return (*getUnmarked(curr)->item == *item);
+                }
+                rcList.release(predNode);
+                pred = &getUnmarked(curr)->next;
+                predNode = getUnmarked(curr);
+            } 
+            else 
+            {
+                if (!rcList.compareExchange(*pred, getUnmarked(curr), getUnmarked(next))) 
+                {
+                    releaseAll(predNode, curr, next);
+                    goto try_again;
+                }
+                rcList.retireNode(curr);
+                rcList.release(curr);
+            }
+            curr = next;
+        }
+        *par_curr = curr;
+        *par_pred = pred;
+        *par_pred_node = predNode;
+        *par_next = next;
+        return false;
+    }
+};
+
+#endif
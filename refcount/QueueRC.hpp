@@ -0,0 +1,159 @@
+#ifndef QUEUE_RC_HPP
+#define QUEUE_RC_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "ReferenceCounting.hpp"
+
+template<typename T>
+class Queue_RC
+{
+
+private:
+    struct Node{
+        T* item;
+        std::atomic<int64_t> refs;
+        bool retired;
+        CountedLink<Node> next;
+
+        Node(T* item) 
+        {
+            this->item = item;
+            this->refs.store(1);
+            this->retired = false;
+        }
+    };
+
+    CountedLink<Node> head;
+    CountedLink<Node> tail;
+    ReferenceCounting<Node> rcQueue;
+
+public:
+
+    Queue_RC() {
+        Node* sentinel = new Node(nullptr);
+        sentinel->refs.store(2);
+        head.init(sentinel);
+        tail.init(sentinel);
+    }
+
+    // The benchmark harness constructs every container with a thread count
+    Queue_RC(int) : Queue_RC() { }
+
+    ~Queue_RC(){
+        while(dequeue() != nullptr);
+        rcQueue.compareExchange(tail, tail.load(), nullptr);
+        rcQueue.compareExchange(head, head.load(), nullptr);
+    }
+
+    bool enqueue(T* item)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = new Node(item);
+        while(true)
+        {
+            Node* temp = rcQueue.acquire(tail);
+            if (temp->next.load() == nullptr) 
+            {
+                if (rcQueue.compareExchange(temp->next, nullptr, node)) 
+                {
+                    rcQueue.compareExchange(tail, temp, node);
+                    rcQueue.release(temp);
+                    rcQueue.release(node);
+                    return true;
+                }
+            } 
+            else 
+            {
+                Node* next = rcQueue.acquire(temp->next);
+                rcQueue.compareExchange(tail, temp, next);
+                rcQueue.release(next);
+            }
+            rcQueue.release(temp);
+        }
+    }
+
+    T* dequeue()
+    {
+        while(true)
+        {
+            Node* node = rcQueue.acquire(head);
+            if (node == tail.load()) 
+            {
+                rcQueue.release(node);
+                return nullptr;
+            }
+            Node* next = rcQueue.acquire(node->next);
+            if (rcQueue.compareExchange(head, node, next)) 
+            {
+                T* item = next->item;
+                rcQueue.retireNode(node);
+                rcQueue.release(next);
+                rcQueue.release(node);
+                return item;
+            }
+            rcQueue.release(next);
+            rcQueue.release(node);
+        }
+    }
+
+    bool enqueue(T* item, int)
+    {
+        return enqueue(item);
+    }
+
+    T* dequeue(int)
+    {
+        return dequeue();
+    }
+
+    // Nodes are not owned by threads, so the whole count is reported on thread 0
+    // Every link change has to go through the counted CAS so that the
+    // reference counts stay exact, so the batch operations are plain loops
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last, int threadID)
+    {
+        bool enqueued = false;
+        for(; first != last; ++first)
+        {
+            enqueued |= enqueue(*first);
+        }
+        return enqueued;
+    }
+
+    int dequeueBatch(int n, T** out, int threadID)
+    {
+        int count = 0;
+        while(count < n)
+        {
+            T* item = dequeue();
+            if(item == nullptr)
+            {
+                break;
+            }
+            out[count++] = item;
+        }
+        return count;
+    }
+
+    std::vector<T*> drain(int threadID)
+    {
+        std::vector<T*> items;
+        while(T* item = dequeue())
+        {
+            items.push_back(item);
+        }
+        return items;
+    }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return threadID == 0 ? rcQueue.getRetiredNodeCount() : 0;
+    }
+};
+
+#endif
@@ -0,0 +1,254 @@
+#ifndef REFERENCE_COUNTING_HPP
+#define REFERENCE_COUNTING_HPP
+
+#include <iostream>
+#include <atomic>
+#include <vector>
+
+#define RC_DEFERRED_DECREMENTS 32
+
+// A link that owns one reference on the node it points to. Its word packs the
+// (possibly marked) pointer in the low 48 bits, an external count in the next
+// 8 and a modification tag in the top 8: readers first borrow the link by
+// bumping the external count, which keeps the node alive until they have taken
+// a reference on the node itself (split reference counting, as in
+// atomic_shared_ptr). Every swing to another node bumps the tag, so a borrow
+// is only handed back to the link it was taken from, even if the link has
+// since come back to the same node. The external count bounds the number of
+// threads borrowing one link at once to 255.
+template<typename Node>
+class CountedLink {
+public:
+    static const uint64_t PTR_MASK = (1ULL << 48) - 1;
+    static const uint64_t EXT_ONE = 1ULL << 48;
+    static const uint64_t EXT_MASK = 0xFFULL << 48;
+    static const uint64_t TAG_ONE = 1ULL << 56;
+    static const uint64_t TAG_MASK = 0xFFULL << 56;
+
+    std::atomic<uint64_t> word;
+
+    CountedLink(Node* ptr = nullptr) : word{(uint64_t)ptr} { }
+
+    // Uncounted read, only good for comparing pointers
+    Node* load() const
+    {
+        return (Node*)(word.load() & PTR_MASK);
+    }
+
+    // For links nobody else can see yet; the caller hands over its reference
+    void init(Node* ptr)
+    {
+        word.store((uint64_t)ptr, std::memory_order_relaxed);
+    }
+};
+
+// Nodes need `std::atomic<int64_t> refs`, `bool retired` and a
+// `CountedLink<Node> next`. There are no per-thread slots: every thread that
+// dereferences a node holds a reference on it, and the last reference frees it
+// (and releases whatever its next link points to).
+//
+// Deferred decrements: releases go to a small thread local buffer first, so a
+// node that is released and acquired again shortly after (the nodes near the
+// front of a list, on every traversal) costs no atomic operation at all.
+template<typename Node>
+class ReferenceCounting {
+
+private:
+    struct DeferredDecrements {
+        Node* nodes[RC_DEFERRED_DECREMENTS];
+        int count = 0;
+
+        ~DeferredDecrements()
+        {
+            flushDeferred(*this);
+        }
+    };
+
+    static thread_local DeferredDecrements deferred;
+    static std::atomic<uint64_t> unreclaimedNodes;
+
+    static Node* getUnmarked(Node* node)
+    {
+        return (Node*)((size_t) node & (~0x1));
+    }
+
+    static Node* ptrOf(uint64_t word)
+    {
+        return (Node*)(word & CountedLink<Node>::PTR_MASK);
+    }
+
+    // Which node the link points to and since which swing; marking the link
+    // keeps both, as it keeps the link's reference and its borrows
+    static uint64_t versionOf(uint64_t word)
+    {
+        return word & (CountedLink<Node>::TAG_MASK | (CountedLink<Node>::PTR_MASK & ~0x1ULL));
+    }
+
+public:
+    ~ReferenceCounting()
+    {
+        flushDeferred(deferred);
+    }
+
+    // Returns the current value of the link, with a reference held on the node.
+    Node* acquire(CountedLink<Node>& link)
+    {
+        Node* ptr = ptrOf(link.word.load());
+        if(getUnmarked(ptr) == nullptr || cancelDeferred(getUnmarked(ptr)))
+        {
+            return ptr;
+        }
+        uint64_t borrowed = link.word.fetch_add(CountedLink<Node>::EXT_ONE);
+        ptr = ptrOf(borrowed);
+        if(getUnmarked(ptr) != nullptr)
+        {
+            getUnmarked(ptr)->refs.fetch_add(1);
+        }
+        uint64_t curr = link.word.load();
+        while(versionOf(curr) == versionOf(borrowed))
+        {
+            if(link.word.compare_exchange_weak(curr, curr - CountedLink<Node>::EXT_ONE))
+            {
+                return ptr;
+            }
+        }
+        // The link moved on and whoever swung it transferred the borrow onto
+        // the node, so give that reference back.
+        if(getUnmarked(ptr) != nullptr)
+        {
+            addRefs(getUnmarked(ptr), -1);
+        }
+        return ptr;
+    }
+
+    // Takes an extra reference for the caller, who must already hold one.
+    Node* retain(Node* node)
+    {
+        if(getUnmarked(node) != nullptr)
+        {
+            getUnmarked(node)->refs.fetch_add(1);
+        }
+        return node;
+    }
+
+    void release(Node* node)
+    {
+        node = getUnmarked(node);
+        if(node == nullptr)
+        {
+            return;
+        }
+        if(deferred.count == RC_DEFERRED_DECREMENTS)
+        {
+            flushDeferred(deferred);
+        }
+        deferred.nodes[deferred.count++] = node;
+    }
+
+    // Swings the link from expected to desired. The caller must hold a
+    // reference on desired; the link takes its own. Changing only the mark
+    // keeps the link's reference and its outstanding borrows.
+    bool compareExchange(CountedLink<Node>& link, Node* expected, Node* desired)
+    {
+        uint64_t curr = link.word.load();
+        if(getUnmarked(expected) == getUnmarked(desired))
+        {
+            while(ptrOf(curr) == expected)
+            {
+                if(link.word.compare_exchange_weak(curr, (curr & ~CountedLink<Node>::PTR_MASK) | (uint64_t)desired))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        retain(desired);
+        while(ptrOf(curr) == expected)
+        {
+            uint64_t tag = (curr + CountedLink<Node>::TAG_ONE) & CountedLink<Node>::TAG_MASK;
+            if(link.word.compare_exchange_weak(curr, tag | (uint64_t)desired))
+            {
+                int64_t borrows = (curr & CountedLink<Node>::EXT_MASK) / CountedLink<Node>::EXT_ONE;
+                if(getUnmarked(expected) != nullptr)
+                {
+                    addRefs(getUnmarked(expected), borrows - 1);
+                }
+                return true;
+            }
+        }
+        if(getUnmarked(desired) != nullptr)
+        {
+            addRefs(getUnmarked(desired), -1);
+        }
+        return false;
+    }
+
+    // Accounting only: the node was unlinked and is now waiting for its last
+    // reference to go away.
+    void retireNode(Node* node)
+    {
+        node = getUnmarked(node);
+        node->retired = true;
+        unreclaimedNodes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t getRetiredNodeCount()
+    {
+        return unreclaimedNodes.load(std::memory_order_relaxed);
+    }
+
+private:
+    static bool cancelDeferred(Node* node)
+    {
+        for(int i = 0; i < deferred.count; i++)
+        {
+            if(deferred.nodes[i] == node)
+            {
+                deferred.nodes[i] = deferred.nodes[--deferred.count];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void flushDeferred(DeferredDecrements& buffer)
+    {
+        while(buffer.count > 0)
+        {
+            addRefs(buffer.nodes[--buffer.count], -1);
+        }
+    }
+
+    // Frees the node when its count drops to zero, then walks down the chain of
+    // next links as long as that frees their targets too. A link pointing back
+    // at its own node is not counted.
+    static void addRefs(Node* node, int64_t delta)
+    {
+        if(node->refs.fetch_add(delta) + delta != 0)
+        {
+            return;
+        }
+        while(node != nullptr)
+        {
+            Node* child = getUnmarked(ptrOf(node->next.word.load()));
+            if(node->retired)
+            {
+                unreclaimedNodes.fetch_sub(1, std::memory_order_relaxed);
+            }
+            delete node;
+            if(child == node || child == nullptr || child->refs.fetch_sub(1) != 1)
+            {
+                return;
+            }
+            node = child;
+        }
+    }
+};
+
+template<typename Node>
+thread_local typename ReferenceCounting<Node>::DeferredDecrements ReferenceCounting<Node>::deferred;
+
+template<typename Node>
+std::atomic<uint64_t> ReferenceCounting<Node>::unreclaimedNodes{0};
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef STACK_RC_HPP
+#define STACK_RC_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "ReferenceCounting.hpp"
+
+template<typename T>
+class Stack_RC {
+private:
+    struct Node {
+        T* item;
+        std::atomic<int64_t> refs;
+        bool retired;
+        CountedLink<Node> next;
+
+        Node(T* item)
+        {
+            this->item = item;
+            this->refs.store(1);
+            this->retired = false;
+        }
+    };
+
+    CountedLink<Node> top;
+    ReferenceCounting<Node> rcStack;
+
+public:
+
+    Stack_RC() {
+        top.init(new Node(nullptr));
+    }
+
+    // The benchmark harness constructs every container with a thread count
+    Stack_RC(int) : Stack_RC() { }
+
+    ~Stack_RC(){
+        while(pop() != nullptr);
+        rcStack.compareExchange(top, top.load(), nullptr);
+    }
+
+    bool push(T* item)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = new Node(item);
+        while(true)
+        {
+            Node* temp = rcStack.acquire(top);
+            node->next.init(temp);
+            if(rcStack.compareExchange(top, temp, node))
+            {
+                rcStack.release(node);
+                return true;
+            }
+            rcStack.release(temp);
+        }   
+    }
+
+    T* pop()
+    {
+        while(true)
+        {
+            Node* temp = rcStack.acquire(top);
+            if(temp == nullptr)
+            {
+                return nullptr;
+            }
+            Node* next = rcStack.acquire(temp->next);
+            if(rcStack.compareExchange(top, temp, next))
+            {
+                T* ret_data = temp->item;
+                rcStack.retireNode(temp);
+                rcStack.release(next);
+                rcStack.release(temp);
+                return ret_data;
+            }
+            rcStack.release(next);
+            rcStack.release(temp);
+        }
+    }
+
+    bool push(T* item, int)
+    {
+        return push(item);
+    }
+
+    T* pop(int)
+    {
+        return pop();
+    }
+
+    // Every link change has to go through the counted CAS so that the
+    // reference counts stay exact, so the batch operations are plain loops
+    template<typename Iterator>
+    bool pushBatch(Iterator first, Iterator last, int threadID)
+    {
+        bool pushed = false;
+        for(; first != last; ++first)
+        {
+            pushed |= push(*first);
+        }
+        return pushed;
+    }
+
+    int popBatch(int n, T** out, int threadID)
+    {
+        int count = 0;
+        while(count < n)
+        {
+            T* item = pop();
+            if(item == nullptr)
+            {
+                break;
+            }
+            out[count++] = item;
+        }
+        return count;
+    }
+
+    std::vector<T*> popAll(int threadID)
+    {
+        std::vector<T*> items;
+        while(T* item = pop())
+        {
+            items.push_back(item);
+        }
+        return items;
+    }
+
+    // Nodes are not owned by threads, so the whole count is reported on thread 0
+    uint64_t getRetiredCountStack(int threadID)
+    {
+        return threadID == 0 ? rcStack.getRetiredNodeCount() : 0;
+    }
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs the shared-memory queue across forked processes: items from several
+// producer processes reach a consumer in each producer's order, and the slot
+// of a process killed in the middle of its operations is recovered
+#include "../hazardpointer/SharedMemoryQueueHazardPointer.hpp"
+
+using namespace std;
+
+#define TEST_PRODUCERS 3
+#define TEST_ITEMS_PER_PRODUCER 100000
+#define TEST_CAPACITY 512
+
+typedef SharedMemoryQueue_HazardPointer<long> ShmQueue;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what)
+{
+    cout << (ok ? "ok   " : "FAIL ") << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static string segmentName(const char* what)
+{
+    return string("/smrtest_") + what + "_" + to_string(getpid());
+}
+
+// Item i of producer p is p * TEST_ITEMS_PER_PRODUCER + i. The queue is
+// smaller than what is sent, so producers wait on a full queue while the
+// parent consumes.
+void fifoAcrossProcesses()
+{
+    string name = segmentName("fifo");
+    ShmQueue::unlink(name);
+    {
+        ShmQueue queue(name, TEST_CAPACITY);
+        vector<pid_t> producers;
+        for (int p = 0; p < TEST_PRODUCERS; p++) {
+            pid_t child = fork();
+            if (child == 0) {
+                ShmQueue handle(name, TEST_CAPACITY);
+                for (long i = 0; i < TEST_ITEMS_PER_PRODUCER; i++) {
+                    while (!handle.enqueue(p * TEST_ITEMS_PER_PRODUCER + i)) {
+                        this_thread::yield();
+                    }
+                }
+                _exit(0);
+            }
+            producers.push_back(child);
+        }
+        vector<long> expected(TEST_PRODUCERS, 0);
+        bool ordered = true;
+        long received = 0;
+        long item;
+        while (received < TEST_PRODUCERS * TEST_ITEMS_PER_PRODUCER) {
+            if (!queue.dequeue(item)) {
+                this_thread::yield();
+                continue;
+            }
+            int p = item / TEST_ITEMS_PER_PRODUCER;
+            ordered = ordered && p >= 0 && p < TEST_PRODUCERS && item % TEST_ITEMS_PER_PRODUCER == expected[p];
+            if (p >= 0 && p < TEST_PRODUCERS) {
+                expected[p]++;
+            }
+            received++;
+        }
+        bool exited = true;
+        for (auto child : producers) {
+            int status;
+            exited = exited && waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+        check(exited, "producer processes finish");
+        check(ordered, "items from each producer process arrive in order");
+        check(!queue.dequeue(item), "nothing is left over");
+    }
+    ShmQueue::unlink(name);
+}
+
+// The child keeps the queue busy, so it is killed holding hazards and a
+// retired list. Every other slot then has to be attachable again, and all
+// nodes but the sentinel, those parked on live retired lists and the one
+// the killed operation may have leaked are free.
+void recoveryAfterKill()
+{
+    string name = segmentName("kill");
+    ShmQueue::unlink(name);
+    {
+        ShmQueue queue(name, TEST_CAPACITY);
+        for (long i = 0; i < TEST_CAPACITY / 2; i++) {
+            queue.enqueue(i);
+        }
+        pid_t child = fork();
+        if (child == 0) {
+            ShmQueue handle(name, TEST_CAPACITY);
+            long item;
+            while (true) {
+                if (handle.dequeue(item)) {
+                    handle.enqueue(item);
+                }
+            }
+        }
+        this_thread::sleep_for(chrono::milliseconds(100));
+        kill(child, SIGKILL);
+        int status;
+        check(waitpid(child, &status, 0) == child && WIFSIGNALED(status), "the busy process is killed");
+
+        long item;
+        while (queue.dequeue(item));
+        vector<unique_ptr<ShmQueue>> handles;
+        bool attached = true;
+        try {
+            for (int i = 1; i < SHM_MAX_PARTICIPANTS; i++) {
+                handles.emplace_back(new ShmQueue(name, TEST_CAPACITY));
+            }
+        } catch (const runtime_error&) {
+            attached = false;
+        }
+        check(attached, "the killed process's slot is attachable again");
+
+        long fit = 0;
+        while (queue.enqueue(fit)) {
+            fit++;
+        }
+        long parked = queue.getRetiredCount();
+        for (auto& handle : handles) {
+            parked += handle->getRetiredCount();
+        }
+        check(fit >= TEST_CAPACITY - 2 - parked, "the killed process leaks at most one node");
+    }
+    ShmQueue::unlink(name);
+}
+
+int main()
+{
+    fifoAcrossProcesses();
+    recoveryAfterKill();
+    return failures == 0 ? 0 : 1;
+}
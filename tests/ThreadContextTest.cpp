@@ -0,0 +1,236 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+
+// Drives the containers through their ThreadContext overloads, which take the
+// thread id from the process-wide registry instead of the caller
+#include "../generic/Queue.hpp"
+#include "../generic/Stack.hpp"
+#include "../generic/List.hpp"
+#include "../generic/FlatCombiningQueue.hpp"
+#include "../generic/WaitFreeQueue.hpp"
+
+using namespace std;
+
+#define TEST_THREADS 8
+// The main thread is registered too
+#define TEST_CONTAINER_THREADS (TEST_THREADS + 1)
+#define TEST_ITEMS 1000
+#define TEST_ROUNDS 20000
+
+static int failures = 0;
+
+static void check(bool ok, const char* what)
+{
+    cout << (ok ? "ok   " : "FAIL ") << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+// Every thread takes an item out and puts it back, so all of them must be
+// there at the end
+template<typename Q>
+void queueKeepsItems(const char* what)
+{
+    vector<int> items(TEST_ITEMS);
+    Q queue(TEST_CONTAINER_THREADS);
+    for (auto& item : items) {
+        queue.enqueue(&item);
+    }
+    vector<thread> threads;
+    for (int t = 0; t < TEST_THREADS; t++) {
+        threads.emplace_back([&] {
+            ThreadContext& context = ThreadContext::current();
+            for (int i = 0; i < TEST_ROUNDS; i++) {
+                int* item = queue.dequeue(context);
+                if (item != nullptr) {
+                    queue.enqueue(item, context);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    int count = 0;
+    while (queue.dequeue() != nullptr) {
+        count++;
+    }
+    check(count == TEST_ITEMS, what);
+}
+
+void stackKeepsItems()
+{
+    vector<int> items(TEST_ITEMS);
+    Stack<int, HazardErasReclaimer> stack(TEST_CONTAINER_THREADS);
+    for (auto& item : items) {
+        stack.push(&item);
+    }
+    vector<thread> threads;
+    for (int t = 0; t < TEST_THREADS; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < TEST_ROUNDS; i++) {
+                int* item = stack.pop();
+                if (item != nullptr) {
+                    stack.push(item);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    check((int)stack.popAll().size() == TEST_ITEMS, "Stack<HazardEras> keeps every item");
+}
+
+void listKeepsItems()
+{
+    vector<int> items(TEST_ITEMS);
+    for (int i = 0; i < TEST_ITEMS; i++) {
+        items[i] = i;
+    }
+    List<int, IBRReclaimer> list(TEST_CONTAINER_THREADS);
+    int before = 0;
+    for (auto& item : items) {
+        list.add(&item);
+    }
+    for (auto& item : items) {
+        before += list.contains(&item);
+    }
+    vector<thread> threads;
+    for (int t = 0; t < TEST_THREADS; t++) {
+        threads.emplace_back([&, t] {
+            ThreadContext& context = ThreadContext::current();
+            for (int i = 0; i < TEST_ROUNDS; i++) {
+                int* item = &items[(i * TEST_THREADS + t) % TEST_ITEMS];
+                if (list.remove(item, context)) {
+                    list.add(item, context);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    int after = 0;
+    for (auto& item : items) {
+        after += list.contains(&item);
+    }
+    check(after == before, "List<IBR> keeps every item");
+}
+
+// Ids are handed out lowest-first, so with two threads registered the second
+// one has id 1, which a container sized for one thread must refuse
+void idAboveThreadCountThrows()
+{
+    ThreadContext::current();
+    Queue<int, HazardPointerReclaimer> queue(1);
+    int item = 0;
+    bool threw = false;
+    thread other([&] {
+        try {
+            queue.enqueue(&item);
+        } catch (const out_of_range&) {
+            threw = true;
+        }
+    });
+    other.join();
+    check(threw, "an id above the container's thread count throws");
+    check(queue.enqueue(&item) && queue.dequeue() == &item, "the thread with id 0 still gets through");
+}
+
+// The hazard pointer domain has MAX_NUMBER_OF_THREADS rows, fewer than the
+// wait-free queue's own WF_QUEUE_MAX_THREADS records
+void reclaimerBoundsThreads()
+{
+    bool threw = false;
+    try {
+        WaitFreeQueue<int, HazardPointerReclaimer> queue(MAX_NUMBER_OF_THREADS + 1);
+    } catch (const runtime_error&) {
+        threw = true;
+    }
+    check(threw, "WaitFreeQueue<HazardPointer> refuses more threads than the domain has rows");
+}
+
+// Two pools on two queues sharing the hazard pointer domain, both using
+// container ids 0 and 1; the domain must still give each thread its own row
+void sharedDomainPoolsOverlap()
+{
+    vector<int> items(2 * TEST_ITEMS);
+    Queue<int, SharedHazardPointerReclaimer> first(2);
+    Queue<int, SharedHazardPointerReclaimer> second(2);
+    for (int i = 0; i < TEST_ITEMS; i++) {
+        first.enqueue(&items[i], 0);
+        second.enqueue(&items[TEST_ITEMS + i], 0);
+    }
+    vector<thread> threads;
+    for (auto queue : {&first, &second}) {
+        for (int tid = 0; tid < 2; tid++) {
+            threads.emplace_back([queue, tid] {
+                for (int i = 0; i < TEST_ROUNDS; i++) {
+                    int* item = queue->dequeue(tid);
+                    if (item != nullptr) {
+                        queue->enqueue(item, tid);
+                    }
+                }
+            });
+        }
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    int count = 0;
+    while (first.dequeue(0) != nullptr) {
+        count++;
+    }
+    while (second.dequeue(0) != nullptr) {
+        count++;
+    }
+    check(count == 2 * TEST_ITEMS, "two pools with overlapping ids share the hazard pointer domain");
+}
+
+// Flat combining has one record per id and no more than FC_MAX_THREADS of
+// them, and the raw-id calls check the id themselves
+void flatCombiningBounds()
+{
+    bool threw = false;
+    try {
+        FlatCombiningQueue<int, HazardPointerReclaimer> queue(FC_MAX_THREADS + 1);
+    } catch (const runtime_error&) {
+        threw = true;
+    }
+    check(threw, "FlatCombiningQueue refuses more than FC_MAX_THREADS threads");
+    threw = false;
+    try {
+        FlatCombiningQueue<int, HazardErasReclaimer> queue(HE_MAX_NUMBER_OF_THREADS + 1);
+    } catch (const runtime_error&) {
+        threw = true;
+    }
+    check(threw, "FlatCombiningQueue<HazardEras> refuses more threads than the domain has rows");
+    FlatCombiningQueue<int, HazardPointerReclaimer> queue(2);
+    int item = 0;
+    threw = false;
+    try {
+        queue.enqueue(&item, 2);
+    } catch (const out_of_range&) {
+        threw = true;
+    }
+    check(threw, "FlatCombiningQueue refuses a raw id above its thread count");
+}
+
+int main()
+{
+    queueKeepsItems<Queue<int, HazardPointerReclaimer>>("Queue<HazardPointer> keeps every item");
+    queueKeepsItems<Queue<int, URCUReclaimer>>("Queue<URCU> keeps every item");
+    queueKeepsItems<FlatCombiningQueue<int, HazardPointerReclaimer>>("FlatCombiningQueue<HazardPointer> keeps every item");
+    stackKeepsItems();
+    listKeepsItems();
+    idAboveThreadCountThrows();
+    sharedDomainPoolsOverlap();
+    reclaimerBoundsThreads();
+    flatCombiningBounds();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+// Forces URCU's tree mode, which the default build leaves off, with readers
+// spread over several leaves of URCU_LEAF_SIZE slots
+#include "../urcu/URCU.hpp"
+
+using namespace std;
+
+#define TEST_READERS 40
+#define TEST_HOLD_MS 200
+#define TEST_STRESS_MS 1000
+
+static int failures = 0;
+
+static void check(bool ok, const char* what)
+{
+    cout << (ok ? "ok   " : "FAIL ") << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+// One reader in the last leaf holds the lock for TEST_HOLD_MS while the
+// readers of the other leaves keep entering and leaving; synchronizeRCU must
+// not return before the holder has left
+void synchronizeWaitsForHolder()
+{
+    static_assert(TEST_READERS > 2 * URCU_LEAF_SIZE, "readers must span more than two leaves");
+    URCU urcu(TEST_READERS, true);
+    atomic<bool> locked{false};
+    atomic<bool> released{false};
+    atomic<bool> stop{false};
+    vector<thread> threads;
+    for (int tid = 0; tid < TEST_READERS - 1; tid++) {
+        threads.emplace_back([&, tid] {
+            while (!stop.load()) {
+                urcu.readLock(tid);
+                urcu.readUnlock(tid);
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        int tid = TEST_READERS - 1;
+        urcu.readLock(tid);
+        locked.store(true);
+        this_thread::sleep_for(chrono::milliseconds(TEST_HOLD_MS));
+        released.store(true);
+        urcu.readUnlock(tid);
+    });
+    while (!locked.load()) {
+        this_thread::yield();
+    }
+    auto start = chrono::steady_clock::now();
+    urcu.synchronizeRCU();
+    auto waited = chrono::steady_clock::now() - start;
+    bool afterRelease = released.load();
+    stop.store(true);
+    for (auto& th : threads) {
+        th.join();
+    }
+    check(afterRelease, "tree-mode synchronizeRCU waits for a reader holding the lock");
+    check(waited >= chrono::milliseconds(TEST_HOLD_MS / 2), "the wait lasts about as long as the reader holds the lock");
+}
+
+struct Object {
+    atomic<bool> alive{true};
+};
+
+// Readers check the object they read is still alive while updaters swap it
+// out and retire it after a grace period
+void readersNeverSeeFreed()
+{
+    URCU urcu(TEST_READERS, true);
+    atomic<Object*> shared{new Object};
+    atomic<bool> stop{false};
+    atomic<long> dead{0};
+    vector<thread> threads;
+    for (int tid = 0; tid < TEST_READERS; tid++) {
+        threads.emplace_back([&, tid] {
+            while (!stop.load()) {
+                if (tid % 8 == 0) {
+                    Object* old = shared.exchange(new Object);
+                    urcu.synchronizeRCU();
+                    old->alive.store(false);
+                    delete old;
+                    continue;
+                }
+                urcu.readLock(tid);
+                Object* object = shared.load();
+                for (int i = 0; i < 16; i++) {
+                    if (!object->alive.load()) {
+                        dead++;
+                    }
+                }
+                urcu.readUnlock(tid);
+            }
+        });
+    }
+    this_thread::sleep_for(chrono::milliseconds(TEST_STRESS_MS));
+    stop.store(true);
+    for (auto& th : threads) {
+        th.join();
+    }
+    delete shared.load();
+    check(dead.load() == 0, "tree-mode readers never see an object retired under them");
+}
+
+int main()
+{
+    synchronizeWaitsForHolder();
+    readersNeverSeeFreed();
+    return failures == 0 ? 0 : 1;
+}
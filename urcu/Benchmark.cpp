@@ -9,7 +9,14 @@
 
 #include "LinkedListURCU.hpp"
 #include "QueueURCU.hpp"
+#include "FAAArrayQueueURCU.hpp"
+#include "MultiQueueURCU.hpp"
+#include "FlatCombiningQueueURCU.hpp"
 #include "StackURCU.hpp"
+#include "EliminationStackURCU.hpp"
+
+// The no-reclamation baseline is each container instantiated with
+// LeakReclaimer from generic/Reclaimers.hpp
 
 using namespace std;
 using namespace chrono;
@@ -18,10 +25,25 @@ class Benchmarks {
 
 private:
     int numThreads;
+    long long baselineOps;
 
 public:
     Benchmarks(int numThreads) {
         this->numThreads = numThreads;
+        this->baselineOps = 0;
+    }
+
+    void setBaselineOps(long long ops) {
+        baselineOps = ops;
+    }
+
+    // Best-run throughput, the statistic printed as Ops/sec, as a percentage of
+    // the no-reclamation run once one is set
+    string baselineReport(long long ops) {
+        if (baselineOps <= 0) {
+            return "";
+        }
+        return ", " + to_string((long)(100. * ops / baselineOps)) + "% of no-reclamation";
     }
 
     template<typename Q>
@@ -103,7 +125,7 @@ public:
 
             for(int thread_index=0; thread_index<numThreads; thread_index++)
             {
-                retired_nodes_count[thread_index][irun] += queue->getRetiredNodesCount(thread_index);
+                retired_nodes_count[thread_index][irun] += queue->getRetiredCountQueue(thread_index);
             }
 
             delete queue;
@@ -139,9 +161,9 @@ public:
         // Printed value is the median of the number of ops per second that all threads were able to accomplish (on average)
         // std::cout << "Ops/sec = " << medianops << "   delta = " << delta << "%   min = " << minops << "   max = " << maxops << "\n";
         
-        std::cout << "Ops/sec = "<< maxops << ", Total unreclaimed nodes = "<< max_retired_nodes<<"\n";
+        std::cout << "Ops/sec = "<< maxops << ", Total unreclaimed nodes = "<< max_retired_nodes<<baselineReport(maxops)<<"\n";
         
-        return medianops;
+        return maxops;
     }
 
     template<typename S>
@@ -220,7 +242,7 @@ public:
 
             for(int thread_index=0; thread_index<numThreads; thread_index++)
             {
-                retired_nodes_count[thread_index][irun] += stack->getRetiredNodesCount(thread_index);
+                retired_nodes_count[thread_index][irun] += stack->getRetiredCountStack(thread_index);
             }
 
             delete stack;
@@ -256,9 +278,9 @@ public:
         // Printed value is the median of the number of ops per second that all threads were able to accomplish (on average)
         // std::cout << "Ops/sec = " << medianops << "   delta = " << delta << "%   min = " << minops << "   max = " << maxops << "\n";
         
-        std::cout << "Ops/sec = " << maxops << ", Total unreclaimed nodes = "<<max_retired_nodes<<" \n";
+        std::cout << "Ops/sec = " << maxops << ", Total unreclaimed nodes = "<<max_retired_nodes<<baselineReport(maxops)<<" \n";
         
-        return medianops;
+        return maxops;
     }
 
     template<typename L>
@@ -341,7 +363,7 @@ public:
 
             for(int thread_index=0; thread_index<numThreads; thread_index++)
             {
-                retired_nodes_count[thread_index][irun] += list->getRetiredNodesCount(thread_index);
+                retired_nodes_count[thread_index][irun] += list->getRetiredCountLinkedList(thread_index);
             }
 
             delete list;
@@ -379,8 +401,8 @@ public:
         // Printed value is the median of the number of ops per second that all threads were able to accomplish (on average)
         // std::cout << "Ops/sec = " << medianops << "   delta = " << delta << "%   min = " << minops << "   max = " << maxops << "\n";
         
-        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<"\n\n";
-        return medianops;
+        std::cout << "Ops/sec = " << maxops <<", Total unreclaimed nodes =  "<<max_retired_nodes<<baselineReport(maxops)<<"\n\n";
+        return maxops;
     }
 };
 
@@ -415,6 +437,10 @@ int main(int argc, char* argv[])
     int total_elements = 10000;
 
     cout<<"\n----- Benchmarking "<<ds_type<<" -----";
+    if(URCU_TREE_MODE)
+    {
+        cout<<"\n URCU tree mode on from "<<URCU_TREE_MIN_THREADS<<" threads";
+    }
     for(int thread_index=0; thread_index < total_threads.size(); thread_index++)
     {
         for(int ratio_index=0; ratio_index < ratio.size(); ratio_index++)
@@ -424,16 +450,53 @@ int main(int argc, char* argv[])
 
             if(strcmp(ds_type, "linkedlist") == 0)
             {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkLinkedList<List<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
                 bench.benchmarkLinkedList<LinkedListURCU<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
             }
             else if(strcmp(ds_type, "queue") == 0)
             {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<Queue<int, LeakReclaimer, QUEUE_NODE_ALLOCATOR>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
                 bench.benchmarkQueues<QueueURCU<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
             }
+            else if(strcmp(ds_type, "faaqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<FAAArrayQueue<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<FAAArrayQueueURCU<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
+            else if(strcmp(ds_type, "multiqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<MultiQueue<int, LeakReclaimer, QUEUE_NODE_ALLOCATOR>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<MultiQueueURCU<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
+            else if(strcmp(ds_type, "fcqueue") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkQueues<FlatCombiningQueue<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkQueues<FlatCombiningQueueURCU<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
             else if(strcmp(ds_type, "stack") == 0)
             {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkStacks<Stack<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
                 bench.benchmarkStacks<StackURCU<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
             }
+            else if(strcmp(ds_type, "eliminationstack") == 0)
+            {
+                std::cout <<" no-reclamation ";
+                bench.setBaselineOps(bench.benchmarkStacks<EliminationStack<int, LeakReclaimer>>(ratio[ratio_index], test_length, total_runs, total_elements));
+                std::cout <<" numThreads=" << total_threads[thread_index] << ",";
+                bench.benchmarkStacks<EliminationStackURCU<int>>(ratio[ratio_index], test_length, total_runs, total_elements);
+            }
             else
             {
                 std::cout<<"ERROR: Enter appropriate data structure\n";
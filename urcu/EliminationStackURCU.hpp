@@ -0,0 +1,9 @@
+#ifndef _ELIMINATION_STACK_URCU_H_
+#define _ELIMINATION_STACK_URCU_H_
+
+#include "../generic/EliminationStack.hpp"
+
+template<typename T>
+using EliminationStackURCU = EliminationStack<T, URCUReclaimer>;
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef _FAA_ARRAY_QUEUE_URCU_H_
+#define _FAA_ARRAY_QUEUE_URCU_H_
+
+#include "../generic/FAAArrayQueue.hpp"
+
+template<typename T>
+using FAAArrayQueueURCU = FAAArrayQueue<T, URCUReclaimer>;
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef FLAT_COMBINING_QUEUE_URCU_HPP
+#define FLAT_COMBINING_QUEUE_URCU_HPP
+
+#include "../generic/FlatCombiningQueue.hpp"
+
+template<typename T>
+using FlatCombiningQueueURCU = FlatCombiningQueue<T, URCUReclaimer>;
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef MULTI_QUEUE_URCU_HPP
+#define MULTI_QUEUE_URCU_HPP
+
+#include "../generic/MultiQueue.hpp"
+
+// Lanes take their nodes from QUEUE_NODE_ALLOCATOR, like the Michael-Scott queue
+template<typename T>
+using MultiQueueURCU = MultiQueue<T, URCUReclaimer, QUEUE_NODE_ALLOCATOR>;
+
+#endif
@@ -2,27 +2,65 @@
 #define _URCU_H_
 
 #include <atomic>
+#include <algorithm>
+
+// Reader slots are grouped into leaves of URCU_LEAF_SIZE readers. In tree mode
+// the grace period is detected through the tree: each leaf publishes a "has
+// readers" bit into the root and synchronizeRCU only scans the leaves whose
+// bit is set, instead of every slot. The price is a CAS on the shared leaf
+// state in every readLock and readUnlock, so tree mode is opt-in: build with
+// -DURCU_TREE_MODE=1 and it is used from URCU_TREE_MIN_THREADS readers up.
+#define URCU_LEAF_SIZE 16
+#define URCU_TREE_MIN_THREADS 64
+#ifndef URCU_TREE_MODE
+#define URCU_TREE_MODE 0
+#endif
 
 class URCU {
     static const uint64_t NOT_READING = 0xFFFFFFFFFFFFFFFE;
     static const uint64_t UNASSIGNED =  0xFFFFFFFFFFFFFFFD;
 
+    // Leaf state word: number of readers inside in the low bits, plus whether
+    // the leaf bit is set in the root or is being set/cleared right now.
+    static const uint64_t LEAF_BUSY = 0x8000000000000000;
+    static const uint64_t LEAF_PUBLISHED = 0x4000000000000000;
+    static const uint64_t LEAF_COUNT_MASK = 0x3FFFFFFFFFFFFFFF;
+
+    struct alignas(64) Leaf {
+        std::atomic<uint64_t> state { 0 };
+    };
+
     const int max_threads;
+    const bool tree_mode;
+    const int num_leaves;
     std::atomic<uint64_t> updaterVersion { 0 };
     std::atomic<uint64_t>* readersVersion;
+    Leaf* leaves;
+    std::atomic<uint64_t>* root;
 
 public:
-    URCU(const int max_threads = 128) : max_threads{max_threads} 
+    URCU(const int max_threads = 128) : URCU(max_threads, URCU_TREE_MODE && max_threads >= URCU_TREE_MIN_THREADS) { }
+
+    URCU(const int max_threads, const bool tree_mode) : max_threads{max_threads}, tree_mode{tree_mode},
+        num_leaves{(max_threads + URCU_LEAF_SIZE - 1) / URCU_LEAF_SIZE}
     {
         readersVersion = new std::atomic<uint64_t>[max_threads];
         for (int i=0; i < max_threads; i++) 
         {
             readersVersion[i].store(UNASSIGNED, std::memory_order_relaxed);
         }
+        leaves = new Leaf[num_leaves];
+        root = new std::atomic<uint64_t>[(num_leaves + 63) / 64];
+        for (int i=0; i < (num_leaves + 63) / 64; i++) 
+        {
+            root[i].store(0, std::memory_order_relaxed);
+        }
     }
 
     ~URCU() {
         delete[] readersVersion;
+        delete[] leaves;
+        delete[] root;
     }
 
     // int registerThread() 
@@ -48,6 +86,10 @@ public:
 
     void readLock(const int thread_id) noexcept 
     {
+        if (tree_mode && readersVersion[thread_id].load(std::memory_order_relaxed) >= UNASSIGNED) 
+        {
+            arriveLeaf(thread_id / URCU_LEAF_SIZE);
+        }
         const uint64_t rv = updaterVersion.load();
         readersVersion[thread_id].store(rv);
         const uint64_t nrv = updaterVersion.load();
@@ -60,7 +102,12 @@ public:
 
     void readUnlock(const int thread_id) noexcept 
     {
+        const bool wasReading = readersVersion[thread_id].load(std::memory_order_relaxed) < UNASSIGNED;
         readersVersion[thread_id].store(NOT_READING, std::memory_order_release);
+        if (tree_mode && wasReading) 
+        {
+            departLeaf(thread_id / URCU_LEAF_SIZE);
+        }
     }
 
     void synchronizeRCU() noexcept 
@@ -68,11 +115,94 @@ public:
         const uint64_t waitForVersion = updaterVersion.load();
         auto tmp = waitForVersion;
         updaterVersion.compare_exchange_strong(tmp, waitForVersion+1);
+        if (tree_mode) 
+        {
+            synchronizeTree(waitForVersion);
+            return;
+        }
         for (int i=0; i < max_threads; i++) 
         {
             while (readersVersion[i].load() <= waitForVersion) { } // spin
         }
     }
+
+private:
+    // The first reader to enter a leaf sets the leaf bit in the root and the
+    // last one to leave clears it. Both transitions hold the leaf in LEAF_BUSY,
+    // so a reader never starts reading before its leaf is visible in the root.
+    void arriveLeaf(const int leaf) noexcept 
+    {
+        while (true) 
+        {
+            uint64_t s = leaves[leaf].state.load();
+            if (s & LEAF_BUSY) 
+            {
+                continue; // spin
+            }
+            if (s & LEAF_PUBLISHED) 
+            {
+                if (leaves[leaf].state.compare_exchange_strong(s, s+1)) return;
+                continue;
+            }
+            if (leaves[leaf].state.compare_exchange_strong(s, LEAF_BUSY | 1)) 
+            {
+                root[leaf / 64].fetch_or(1ULL << (leaf % 64));
+                leaves[leaf].state.store(LEAF_PUBLISHED | 1);
+                return;
+            }
+        }
+    }
+
+    void departLeaf(const int leaf) noexcept 
+    {
+        while (true) 
+        {
+            uint64_t s = leaves[leaf].state.load();
+            if ((s & LEAF_COUNT_MASK) > 1) 
+            {
+                if (leaves[leaf].state.compare_exchange_strong(s, s-1)) return;
+                continue;
+            }
+            if (leaves[leaf].state.compare_exchange_strong(s, LEAF_BUSY)) 
+            {
+                root[leaf / 64].fetch_and(~(1ULL << (leaf % 64)));
+                leaves[leaf].state.store(0);
+                return;
+            }
+        }
+    }
+
+    bool isLeafQuiescent(const int leaf, const uint64_t waitForVersion) noexcept 
+    {
+        const int last = std::min((leaf + 1) * URCU_LEAF_SIZE, max_threads);
+        for (int i = leaf * URCU_LEAF_SIZE; i < last; i++) 
+        {
+            if (readersVersion[i].load() <= waitForVersion) return false;
+        }
+        return true;
+    }
+
+    // Only leaves that had readers when the new version was published can hold
+    // an old reader. A leaf is done once all its slots moved past the old
+    // version, or once its root bit is cleared (every reader in it has left).
+    void synchronizeTree(const uint64_t waitForVersion) noexcept 
+    {
+        for (int w = 0; w < (num_leaves + 63) / 64; w++) 
+        {
+            uint64_t pending = root[w].load();
+            while (pending != 0) 
+            {
+                for (uint64_t bits = pending; bits != 0; bits &= bits - 1) 
+                {
+                    const int bit = __builtin_ctzll(bits);
+                    if (!(root[w].load() & (1ULL << bit)) || isLeafQuiescent(w * 64 + bit, waitForVersion)) 
+                    {
+                        pending &= ~(1ULL << bit);
+                    }
+                }
+            }
+        }
+    }
 };
 
 #endif
@@ -0,0 +1,181 @@
+#ifndef LINKED_LIST_VBR_HPP
+#define LINKED_LIST_VBR_HPP
+
+#include <atomic>
+#include <iostream>
+#include "VersionBasedReclamation.hpp"
+
+template<typename T>
+class LinkedList_VBR {
+
+private:
+    struct Node {
+        std::atomic<T*> item{nullptr};
+        std::atomic<uint64_t> birth_epoch{0};
+        std::atomic<uint64_t> retire_epoch{0};
+        VersionedLink<Node> next;
+    };
+
+    bool isMarked(Node * node) {
+    	return ((size_t) node & 0x1);
+    }
+
+    Node * getMarked(Node * node) {
+    	return (Node*)((size_t) node | 0x1);
+    }
+
+    Node * getUnmarked(Node * node) {
+    	return (Node*)((size_t) node & (~0x1));
+    }
+
+    VersionedLink<Node> head;
+    Node* tail;
+    int numThreads;
+    VersionBasedReclamation<Node> vbrList {numThreads};
+
+public:
+
+    LinkedList_VBR(int numThreads) : numThreads{numThreads}
+    {
+        Node* sentinel = vbrList.allocNode(0);
+        tail = sentinel;
+        head.init(sentinel, vbrList.getEra());
+        sentinel->next.init(tail, vbrList.getEra());
+    }
+
+    // Every node, removed or not, belongs to the pool and is freed with it
+    ~LinkedList_VBR()
+    {
+    }
+
+    bool add(T* item, int threadID)
+    {
+        Node *curr, *next;
+        VersionedLink<Node> *pred;
+        uint64_t predVersion, currVersion;
+        Node* node = vbrList.allocNode(threadID);
+        node->item.store(item, std::memory_order_relaxed);
+        while (true) {
+            if (find(item, &pred, &predVersion, &curr, &next, &currVersion, threadID)) 
+            {
+                vbrList.releaseNode(node, threadID);
+                return false;
+            }
+            node->next.init(getUnmarked(curr), vbrList.getEra());
+            if (pred->compareExchange(getUnmarked(curr), predVersion, node, vbrList.getEra())) 
+            {
+                return true;
+            }
+        }
+    }
+
+    bool remove(T* item, int threadID)
+    {
+        Node *curr, *next;
+        VersionedLink<Node> *pred;
+        uint64_t predVersion, currVersion;
+        while (true) 
+        {
+            if (!find(item, &pred, &predVersion, &curr, &next, &currVersion, threadID)) {
+                return false;
+            }
+            uint64_t era = vbrList.getEra();
+            if (!getUnmarked(curr)->next.compareExchange(getUnmarked(next), currVersion, getMarked(next), era)) {
+                continue;
+            }
+            if (pred->compareExchange(getUnmarked(curr), predVersion, getUnmarked(next), era)) 
+            {
+                vbrList.retireNode(getUnmarked(curr), threadID);
+            }
+            return true;
+        }
+    }
+
+    bool contains (T* item, int threadID)
+    {
+        Node *curr, *next;
+        VersionedLink<Node> *pred;
+        uint64_t predVersion, currVersion;
+        return find(item, &pred, &predVersion, &curr, &next, &currVersion, threadID);
+    }
+
+    uint64_t getRetiredCountLinkedList(int threadID)
+    {
+        return vbrList.getRetiredNodeCount(threadID);
+    }
+
+
+private:
+
+    // The traversal writes nothing shared: every read from a node is checked
+    // against the epoch taken at try_again, and the versions returned with
+    // pred and curr make the caller's CAS fail if either node was recycled
+    // in the meantime.
+    bool find (T* item, VersionedLink<Node> **par_pred, uint64_t *par_predVersion, Node **par_curr, Node **par_next, uint64_t *par_currVersion, const int threadID)
+    {
+        VersionedLink<Node> *pred;
+        Node *curr, *next;
+        uint64_t predVersion, currVersion, checkVersion;
+     try_again:
+        vbrList.start_op(threadID);
+        pred = &head;
+        curr = pred->load(&predVersion);
+        while (true) {
+            if (getUnmarked(curr) == nullptr) 
+            {
+                break;
+            }
+            next = getUnmarked(curr)->next.load(&currVersion);
+            if (!vbrList.validate(threadID)) 
+            {
+                goto try_again;
+            }
+            if (getUnmarked(next) == tail) 
+            {
+                break;
+            }
+            if (pred->load(&checkVersion) != getUnmarked(curr) || checkVersion != predVersion) 
+            {
+                goto try_again;
+            }
+            if (getUnmarked(next) == next) 
+            {
+                T* currItem = getUnmarked(curr)->item.load(std::memory_order_relaxed);
+                if (!vbrList.validate(threadID)) 
+                {
+                    goto try_again;
+                }
+                if (currItem != nullptr && !(*currItem < *item)) 
+                {
+                    *par_curr = curr;
+                    *par_pred = pred;
+                    *par_predVersion = predVersion;
+                    *par_next = next;
+                    *par_currVersion = currVersion;
+                    return (*currItem == *item);
+                }
+                pred = &getUnmarked(curr)->next;
+                predVersion = currVersion;
+            } 
+            else 
+            {
+                uint64_t era = vbrList.getEra();
+                if (!pred->compareExchange(getUnmarked(curr), predVersion, getUnmarked(next), era)) 
+                {
+                    goto try_again;
+                }
+                vbrList.retireNode(getUnmarked(curr), threadID);
+                predVersion = (era > predVersion) ? era : predVersion;
+            }
+            curr = next;
+        }
+        *par_curr = curr;
+        *par_pred = pred;
+        *par_predVersion = predVersion;
+        *par_next = next;
+        *par_currVersion = currVersion;
+        return false;
+    }
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef QUEUE_VBR_HPP
+#define QUEUE_VBR_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "VersionBasedReclamation.hpp"
+
+template<typename T>
+class Queue_VBR
+{
+
+private:
+    struct Node{
+        std::atomic<T*> item{nullptr};
+        std::atomic<uint64_t> birth_epoch{0};
+        std::atomic<uint64_t> retire_epoch{0};
+        VersionedLink<Node> next;
+    };
+
+    VersionedLink<Node> head;
+    VersionedLink<Node> tail;
+    const int numOfThreads;
+    VersionBasedReclamation<Node> vbrQueue{numOfThreads};
+
+public:
+
+    Queue_VBR(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = vbrQueue.allocNode(0);
+        sentinel->next.init(nullptr, vbrQueue.getEra());
+        head.init(sentinel, vbrQueue.getEra());
+        tail.init(sentinel, vbrQueue.getEra());
+    }
+
+    // Every node, dequeued or not, belongs to the pool and is freed with it
+    ~Queue_VBR(){
+    }
+
+    bool enqueue(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = vbrQueue.allocNode(threadID);
+        node->item.store(item, std::memory_order_relaxed);
+        node->next.init(nullptr, vbrQueue.getEra());
+        while(true)
+        {
+            uint64_t tailVersion, nextVersion, checkVersion;
+            Node* temp = tail.load(&tailVersion);
+            Node* next = temp->next.load(&nextVersion);
+            // An unchanged tail means temp was still live when next was read
+            if (temp == tail.load(&checkVersion) && checkVersion == tailVersion)
+            {
+                if (next == nullptr) 
+                {
+                    if (temp->next.compareExchange(nullptr, nextVersion, node, vbrQueue.getEra()))
+                    {
+                        tail.compareExchange(temp, tailVersion, node, vbrQueue.getEra());
+                        return true;
+                    }
+                } 
+                else 
+                {
+                    tail.compareExchange(temp, tailVersion, next, vbrQueue.getEra());
+                }
+            }
+        }
+    }
+
+    T* dequeue(int threadID)
+    {
+        uint64_t headVersion;
+        Node* node = head.load(&headVersion);
+        while (node != tail.load()) 
+        {
+            Node* next = node->next.load();
+            // The item is read before the CAS since next may be dequeued and
+            // recycled as soon as head moves past node
+            T* item = (next == nullptr) ? nullptr : next->item.load(std::memory_order_relaxed);
+            if (next != nullptr && head.compareExchange(node, headVersion, next, vbrQueue.getEra()))
+            {
+                vbrQueue.retireNode(node, threadID);
+                return item;
+            }
+            node = head.load(&headVersion);
+        }
+        return nullptr;
+    }
+
+    // Links the items into a private chain, appends it with one CAS on the
+    // last node's next and then swings tail to the end of the chain. Null
+    // items are skipped.
+    template<typename Iterator>
+    bool enqueueBatch(Iterator first, Iterator last, int threadID)
+    {
+        Node* chainFirst = nullptr;
+        Node* chainLast = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = vbrQueue.allocNode(threadID);
+            node->item.store(*first, std::memory_order_relaxed);
+            node->next.init(nullptr, vbrQueue.getEra());
+            if(chainLast == nullptr)
+            {
+                chainFirst = node;
+            }
+            else
+            {
+                chainLast->next.init(node, vbrQueue.getEra());
+            }
+            chainLast = node;
+        }
+        if(chainFirst == nullptr)
+        {
+            return false;
+        }
+        while(true)
+        {
+            uint64_t tailVersion, nextVersion, checkVersion;
+            Node* temp = tail.load(&tailVersion);
+            Node* next = temp->next.load(&nextVersion);
+            if (temp == tail.load(&checkVersion) && checkVersion == tailVersion)
+            {
+                if (next == nullptr) 
+                {
+                    if (temp->next.compareExchange(nullptr, nextVersion, chainFirst, vbrQueue.getEra()))
+                    {
+                        tail.compareExchange(temp, tailVersion, chainLast, vbrQueue.getEra());
+                        return true;
+                    }
+                } 
+                else 
+                {
+                    tail.compareExchange(temp, tailVersion, next, vbrQueue.getEra());
+                }
+            }
+        }
+    }
+
+    // One dequeue per item: nodes past head may be recycled at any time, so
+    // a walk over several of them could not be validated by one CAS
+    int dequeueBatch(int n, T** out, int threadID)
+    {
+        int count = 0;
+        while(count < n)
+        {
+            T* item = dequeue(threadID);
+            if(item == nullptr)
+            {
+                break;
+            }
+            out[count++] = item;
+        }
+        return count;
+    }
+
+    std::vector<T*> drain(int threadID)
+    {
+        std::vector<T*> items;
+        while(T* item = dequeue(threadID))
+        {
+            items.push_back(item);
+        }
+        return items;
+    }
+
+    uint64_t getRetiredCountQueue(int threadID)
+    {
+        return vbrQueue.getRetiredNodeCount(threadID);
+    }
+};
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef STACK_VBR_HPP
+#define STACK_VBR_HPP
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "VersionBasedReclamation.hpp"
+
+template<typename T>
+class Stack_VBR {
+private:
+    struct Node {
+        std::atomic<T*> item{nullptr};
+        std::atomic<uint64_t> birth_epoch{0};
+        std::atomic<uint64_t> retire_epoch{0};
+        VersionedLink<Node> next;
+    };
+
+    VersionedLink<Node> top;
+    const int numOfThreads;
+    VersionBasedReclamation<Node> vbrStack{numOfThreads};
+
+public:
+
+    Stack_VBR(int numOfThreads) : numOfThreads{numOfThreads} {
+        Node* sentinel = vbrStack.allocNode(0);
+        sentinel->next.init(nullptr, vbrStack.getEra());
+        top.init(sentinel, vbrStack.getEra());
+    }
+
+    // Every node, popped or not, belongs to the pool and is freed with it
+    ~Stack_VBR(){
+    }
+
+    bool push(T* item, int threadID)
+    {
+        if(item == nullptr)
+        {
+            return false;
+        }
+        Node* node = vbrStack.allocNode(threadID);
+        node->item.store(item, std::memory_order_relaxed);
+        while(true)
+        {
+            uint64_t version;
+            Node* temp = top.load(&version);
+            node->next.init(temp, vbrStack.getEra());
+            if(top.compareExchange(temp, version, node, vbrStack.getEra()))
+            {
+                return true;
+            }
+        }
+    }
+
+    // No validation is needed here: if temp was popped and recycled after
+    // it was read, top has a newer version and the CAS fails.
+    T* pop(int threadID)
+    {
+        Node *temp, *next;
+        T* ret_data;
+        while(true)
+        {
+            uint64_t version;
+            temp = top.load(&version);
+            if(temp == nullptr)
+            {
+                return nullptr;
+            }
+            next = temp->next.load();
+            if(top.compareExchange(temp, version, next, vbrStack.getEra()))
+            {
+                ret_data = temp->item.load(std::memory_order_relaxed);
+                vbrStack.retireNode(temp, threadID);
+                return ret_data;
+            }
+        }
+    }
+
+    // Links the items into a private chain and splices it onto top with one
+    // CAS, so the last item ends up on top. Null items are skipped.
+    template<typename Iterator>
+    bool pushBatch(Iterator first, Iterator last, int threadID)
+    {
+        Node* bottom = nullptr;
+        Node* chain = nullptr;
+        for(; first != last; ++first)
+        {
+            if(*first == nullptr)
+            {
+                continue;
+            }
+            Node* node = vbrStack.allocNode(threadID);
+            node->item.store(*first, std::memory_order_relaxed);
+            node->next.init(chain, vbrStack.getEra());
+            if(bottom == nullptr)
+            {
+                bottom = node;
+            }
+            chain = node;
+        }
+        if(chain == nullptr)
+        {
+            return false;
+        }
+        while(true)
+        {
+            uint64_t version;
+            Node* temp = top.load(&version);
+            bottom->next.init(temp, vbrStack.getEra());
+            if(top.compareExchange(temp, version, chain, vbrStack.getEra()))
+            {
+                return true;
+            }
+        }
+    }
+
+    // One pop per item: the nodes below top may be recycled at any time, so
+    // the chain cannot be walked to detach several at once
+    int popBatch(int n, T** out, int threadID)
+    {
+        int count = 0;
+        while(count < n)
+        {
+            T* item = pop(threadID);
+            if(item == nullptr)
+            {
+                break;
+            }
+            out[count++] = item;
+        }
+        return count;
+    }
+
+    // Takes the whole stack with one CAS; the detached chain is private and
+    // is retired node by node. Items come out in pop order.
+    std::vector<T*> popAll(int threadID)
+    {
+        std::vector<T*> items;
+        Node* node;
+        while(true)
+        {
+            uint64_t version;
+            node = top.load(&version);
+            if(node == nullptr)
+            {
+                return items;
+            }
+            if(top.compareExchange(node, version, nullptr, vbrStack.getEra()))
+            {
+                break;
+            }
+        }
+        while(node != nullptr)
+        {
+            Node* next = node->next.load();
+            T* item = node->item.load(std::memory_order_relaxed);
+            if(item != nullptr)
+            {
+                items.push_back(item);
+            }
+            vbrStack.retireNode(node, threadID);
+            node = next;
+        }
+        return items;
+    }
+
+    uint64_t getRetiredCountStack(int threadID)
+    {
+        return vbrStack.getRetiredNodeCount(threadID);
+    }
+};
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef VERSION_BASED_RECLAMATION_HPP
+#define VERSION_BASED_RECLAMATION_HPP
+
+#include <iostream>
+#include <atomic>
+#include <vector>
+#include <deque>
+
+#define MAX_NUMBER_OF_THREADS_VBR 40
+#define VBR_REUSE_THRESHOLD 64
+
+// A pointer paired with a version, updated together with a double-width CAS.
+// The version is the global epoch at the time of the update, so it never goes
+// down at a given location, and a node recycled out of the pool starts its
+// links at a strictly newer epoch: a CAS prepared against the node's previous
+// life always fails.
+template<typename Node>
+class VersionedLink {
+private:
+    alignas(16) uint64_t words[2]; // [0] pointer (bit 0 is the mark), [1] version
+
+public:
+    VersionedLink(Node* ptr = nullptr, uint64_t version = 0)
+    {
+        words[0] = (uint64_t)ptr;
+        words[1] = version;
+    }
+
+    // Consistent snapshot of the pair without writing to shared memory
+    Node* load(uint64_t* version) const
+    {
+        while(true)
+        {
+            uint64_t v1 = __atomic_load_n(&words[1], __ATOMIC_ACQUIRE);
+            uint64_t ptr = __atomic_load_n(&words[0], __ATOMIC_ACQUIRE);
+            uint64_t v2 = __atomic_load_n(&words[1], __ATOMIC_ACQUIRE);
+            if(v1 == v2)
+            {
+                *version = v1;
+                return (Node*)ptr;
+            }
+        }
+    }
+
+    Node* load() const
+    {
+        return (Node*)__atomic_load_n(&words[0], __ATOMIC_ACQUIRE);
+    }
+
+    void init(Node* ptr, uint64_t version)
+    {
+        __atomic_store_n(&words[1], version, __ATOMIC_RELEASE);
+        __atomic_store_n(&words[0], (uint64_t)ptr, __ATOMIC_RELEASE);
+    }
+
+    bool compareExchange(Node* expected, uint64_t expectedVersion, Node* desired, uint64_t desiredVersion)
+    {
+        if(desiredVersion < expectedVersion)
+        {
+            desiredVersion = expectedVersion;
+        }
+        unsigned __int128 exp = ((unsigned __int128)expectedVersion << 64) | (uint64_t)expected;
+        unsigned __int128 des = ((unsigned __int128)desiredVersion << 64) | (uint64_t)desired;
+        return __sync_bool_compare_and_swap((unsigned __int128*)words, exp, des);
+    }
+};
+
+// Nodes are never handed back to the allocator while the domain lives: a
+// retired node goes to its thread's pool and is handed out again by
+// allocNode once the global epoch has moved past its retire epoch. Nodes need
+// a default constructor and atomic `birth_epoch` and `retire_epoch` fields.
+//
+// Readers publish nothing. They remember the epoch at start_op and call
+// validate after reading from a node; if the epoch moved, a node they read
+// may have been recycled and the operation restarts.
+template<typename T>
+class VersionBasedReclamation{
+
+private:
+    std::atomic<uint64_t> globalEpoch{1};
+    int numThreads;
+    uint64_t localEpoch[MAX_NUMBER_OF_THREADS_VBR];
+    std::deque<T*> retiredList[MAX_NUMBER_OF_THREADS_VBR];
+    std::vector<T*> allocatedNodes[MAX_NUMBER_OF_THREADS_VBR];
+
+public:
+    VersionBasedReclamation(int threadCount)
+    {
+        numThreads = threadCount;
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_VBR; i++)
+        {
+            localEpoch[i] = 0;
+        }
+    }
+
+    ~VersionBasedReclamation()
+    {
+        for(int i = 0; i < MAX_NUMBER_OF_THREADS_VBR; i++)
+        {
+            for(auto node : allocatedNodes[i])
+            {
+                delete node;
+            }
+        }
+    }
+
+    uint64_t getEra()
+    {
+        return globalEpoch.load(std::memory_order_acquire);
+    }
+
+    void start_op(int threadID)
+    {
+        localEpoch[threadID] = globalEpoch.load(std::memory_order_acquire);
+    }
+
+    bool validate(int threadID)
+    {
+        return globalEpoch.load(std::memory_order_acquire) == localEpoch[threadID];
+    }
+
+    T* allocNode(int threadID)
+    {
+        T* node;
+        if(retiredList[threadID].size() > VBR_REUSE_THRESHOLD)
+        {
+            node = retiredList[threadID].front();
+            retiredList[threadID].pop_front();
+            uint64_t e = globalEpoch.load(std::memory_order_acquire);
+            if(node->retire_epoch.load(std::memory_order_relaxed) >= e)
+            {
+                globalEpoch.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+            }
+        }
+        else
+        {
+            node = new T();
+            allocatedNodes[threadID].push_back(node);
+        }
+        node->birth_epoch.store(globalEpoch.load(std::memory_order_acquire), std::memory_order_release);
+        return node;
+    }
+
+    void retireNode(T* obj, int threadID)
+    {
+        if(obj == nullptr)
+        {
+            return;
+        }
+        obj->retire_epoch.store(globalEpoch.load(std::memory_order_acquire), std::memory_order_release);
+        retiredList[threadID].push_back(obj);
+    }
+
+    // Hands back a node that was never made reachable; it can be reused
+    // right away
+    void releaseNode(T* obj, int threadID)
+    {
+        obj->retire_epoch.store(0, std::memory_order_relaxed);
+        retiredList[threadID].push_front(obj);
+    }
+
+    // Retired nodes that are still waiting in the pool to be recycled
+    uint64_t getRetiredNodeCount(int threadID)
+    {
+        return retiredList[threadID].size();
+    }
+};
+#endif